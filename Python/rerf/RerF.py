@@ -178,7 +178,7 @@ def fastPredict(X, forest):
     if X.ndim == 1:
         predictions = forest._predict(X.tolist())
     else:
-        predictions = forest._predict_numpy(X)
+        predictions = forest._predict_batch(X)
     return predictions
 
 
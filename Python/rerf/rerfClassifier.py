@@ -1,4 +1,6 @@
 import multiprocessing
+import os
+import tempfile
 from warnings import warn
 
 import numpy as np
@@ -76,8 +78,6 @@ class rerfClassifier(BaseEstimator, ClassifierMixin):
         feature_combination / n_features.
     oob_score : bool (default=False)
         Whether to use out-of-bag samples to estimate the generalization accuracy.
-        Note, setting to True currently runs our non-binned implementation
-        which has slower prediction times.
     n_jobs : int or None, optional (default=None)
         The number of jobs to run in parallel for both `fit` and `predict`.
         ``None`` means 1. ``-1`` means use all processors.
@@ -219,27 +219,12 @@ class rerfClassifier(BaseEstimator, ClassifierMixin):
         self.forest_ = pyfp.fpForest()
 
         if self.projection_matrix == "Base":
-            if self.oob_score:
-                forestType = "rfBase"
-            else:
-                forestType = "binnedBase"
+            forestType = "binnedBase"
             self.method_to_use_ = None
         elif self.projection_matrix == "RerF":
-            if self.oob_score:
-                forestType = "rerf"
-            else:
-                forestType = "binnedBaseTern"
+            forestType = "binnedBaseTern"
             self.method_to_use_ = 1
         elif self.projection_matrix == "S-RerF":
-            if self.oob_score:
-                warn(
-                    "OOB is not currently implemented for the S-RerF"
-                    " algorithm.  Continuing with oob_score = False.",
-                    RuntimeWarning,
-                    stacklevel=2,
-                )
-                self.oob_score = False
-
             forestType = "binnedBaseTern"  # this should change
             self.method_to_use_ = 2
             # Check that image_height and image_width are divisors of
@@ -323,6 +308,9 @@ class rerfClassifier(BaseEstimator, ClassifierMixin):
             raise ValueError("max_features has unexpected value")
         self.forest_.setParameter("mtry", self.mtry_)
 
+        if self.oob_score:
+            self.forest_.setParameter("computeOOB", 1)
+
         # Explicitly setting for numpy input
         self.forest_.setParameter("useRowMajor", 1)
 
@@ -339,6 +327,30 @@ class rerfClassifier(BaseEstimator, ClassifierMixin):
 
         return self
 
+    def __getstate__(self):
+        """Pickles the fitted forest as the bytes of its saved file."""
+        state = self.__dict__.copy()
+        if "forest_" in state:
+            with tempfile.TemporaryDirectory() as directory:
+                forest_file = os.path.join(directory, "forest.fp")
+                self.forest_.save(forest_file)
+                with open(forest_file, "rb") as f:
+                    state["forest_"] = f.read()
+        return state
+
+    def __setstate__(self, state):
+        forest_bytes = state.get("forest_")
+        if forest_bytes is not None:
+            forest = pyfp.fpForest()
+            with tempfile.TemporaryDirectory() as directory:
+                forest_file = os.path.join(directory, "forest.fp")
+                with open(forest_file, "wb") as f:
+                    f.write(forest_bytes)
+                forest.load(forest_file)
+            forest.setParameter("numCores", state["n_jobs_"])
+            state["forest_"] = forest
+        self.__dict__.update(state)
+
     def predict(self, X):
         """Predict class for X.
 
@@ -362,7 +374,7 @@ class rerfClassifier(BaseEstimator, ClassifierMixin):
         if X.ndim == 1:
             predictions = self.forest_._predict(X.tolist())
         else:
-            predictions = self.forest_._predict_numpy(X)
+            predictions = self.forest_._predict_batch(X)
         return predictions
 
     def predict_proba(self, X):
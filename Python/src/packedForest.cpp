@@ -65,6 +65,22 @@ PYBIND11_MODULE(pyfp, m)
             return predictions;
         })
 
+        .def("_predict_batch", [](fpForest<double> &self, py::array_t<double, py::array::c_style | py::array::forcecast> mat) {
+            py::buffer_info buf = mat.request();
+            const double *ptr = (double *)buf.ptr;
+            int numObservations = buf.shape[0];
+            int numFeatures = buf.shape[1];
+
+            py::array_t<int> predictions(numObservations);
+            int *predictionsPtr = (int *)predictions.request().ptr;
+            {
+                py::gil_scoped_release release;
+                self.predictBatch(ptr, numObservations, numFeatures, true, predictionsPtr);
+            }
+            return predictions;
+        },
+             "Predicts every row of a 2d array in parallel without copying it.")
+
         .def("_predict_post", &fpForest<double>::predictPost, "Returns a vector representing the votes for each class.")
 
         .def("_predict_post_array", [](fpForest<double> &self, py::array_t<double, py::array::c_style | py::array::forcecast> mat) {
@@ -90,7 +106,18 @@ PYBIND11_MODULE(pyfp, m)
 
         .def("_report_OOB", &fpForest<double>::reportOOB, "Returns the out of bag score on the forest.")
 
+        .def("save", &fpForest<double>::save, py::arg("fileName"),
+             "Saves the grown forest to a versioned binary file.")
+        .def("load", &fpForest<double>::load, py::arg("fileName"),
+             "Replaces the forest with one saved by save.  Binned forests predict from the memory mapped file in place.")
+        .def("writeSource", &fpForest<double>::writeSource, py::arg("fileName"), py::arg("functionName") = "predictBatch",
+             "Writes a grown binned forest as C++ source defining an extern \"C\" predictBatch.")
+
         .def("testAccuracy", &fpForest<double>::testAccuracy);
+
+    m.def("convertCSVToBinary", &convertCSVToBinary<double>,
+          py::arg("CSVFileName"), py::arg("columnWithY"), py::arg("binaryFileName"), py::arg("numThreads") = 1,
+          "Converts a csv file to the binary dataset format read through the binaryFileName parameter.");
 }
 
 } // namespace fp
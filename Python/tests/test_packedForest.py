@@ -79,3 +79,22 @@ def test_predict_post_numpy():
     # sum should be number of trees for each obs
     for p in posts:
         assert sum(p) == 10
+
+
+def test_predict_batch():
+    forest = pyfp.fpForest()
+    forest.setParameter("CSVFileName", "packedForest/res/iris.csv")
+    forest.setParameter("numTreesInForest", 10)
+    forest.setParameter("minParent", 1)
+    forest.setParameter("columnWithY", 4)
+    forest.setParameter("seed", -1661580697)
+    forest.setParameter("forestType", "binnedBase")
+    forest._growForest()
+
+    obs = np.random.rand(20, 4) * 5
+
+    predictions = forest._predict_batch(obs)
+
+    assert len(predictions) == 20
+    for row, prediction in zip(obs, predictions):
+        assert prediction == forest._predict(row.tolist())
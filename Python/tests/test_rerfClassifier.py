@@ -2,6 +2,7 @@
 # https://github.com/scikit-learn-contrib/project-template/blob/master/skltemplate/tests/test_template.py
 
 import math
+import pickle
 import re
 
 import numpy as np
@@ -232,3 +233,19 @@ def test_labels():
         ValueError, match=re.escape("Labels must be contiguous from [0, k-1]")
     ):
         clf.fit(X, y)
+
+
+@pytest.mark.parametrize("projection_matrix", ("RerF", "Base"))
+def test_pickle(projection_matrix):
+    iris_full = datasets.load_iris()
+    clf = rerfClassifier(
+        n_estimators=20, projection_matrix=projection_matrix, oob_score=True
+    )
+    clf.fit(iris_full.data, iris_full.target)
+
+    clf_loaded = pickle.loads(pickle.dumps(clf))
+    assert np.array_equal(clf.predict(iris_full.data), clf_loaded.predict(iris_full.data))
+    assert np.array_equal(
+        clf.predict_proba(iris_full.data), clf_loaded.predict_proba(iris_full.data)
+    )
+    assert clf.oob_score_ == clf_loaded.oob_score_
@@ -69,15 +69,10 @@ class forestPackingRConversion{
 			int numObservations = mat.nrow();
 			int numFeatures = mat.ncol();
 
-			std::vector<double> currObs(numFeatures);
 			Rcpp::IntegerVector predictions(numObservations);
 
-			for(int i = 0; i < numObservations; i++){
-				for(int j = 0; j < numFeatures; j++){
-					currObs[j] = mat(i,j);
-				}
-				predictions[i] = forest.predict(currObs);
-			}
+			//R matrices are column major.
+			forest.predictBatch(mat.begin(), numObservations, numFeatures, false, predictions.begin());
 			return predictions;
 		}
 };
@@ -0,0 +1,81 @@
+#include "../src/packedForest.h"
+#include "syntheticData.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <dlfcn.h>
+
+// Checks and times a forest compiled to C++ by fpForest::writeSource:
+//   ./compiledForest [forestType [numTrees [maxDepth]]]
+// The forest is written to compiledForest.gen.cpp, compiled with $CXX
+// (g++ by default) into compiledForest.gen.so and loaded.  Its predictions
+// must match predictBatch for every observation; the exit status is the
+// number that differ, capped at 1.  Defaults to 64 binnedBase trees of
+// depth at most 10.
+
+typedef void (*predictBatchFunction)(const double* X, int numObservations, int numFeatures, bool rowMajor, int* predictions);
+
+int main(int argc, char* argv[]) {
+	const std::string forestType = argc > 1 ? argv[1] : "binnedBase";
+	const int numTrees = argc > 2 ? atoi(argv[2]) : 64;
+	const int maxDepth = argc > 3 ? atoi(argv[3]) : 10;
+
+	const int numObs = 100000;
+	const int numFeatures = 20;
+
+	std::vector<double> X, colMajorX;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 11, X, Y, &colMajorX);
+
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", forestType);
+	forest.setParameter("numTreesInForest", numTrees);
+	forest.setParameter("maxDepth", maxDepth);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+	forest.writeSource("compiledForest.gen.cpp", "predictBatch");
+
+	const char* compiler = std::getenv("CXX");
+	const std::string compileCommand = std::string(compiler ? compiler : "g++") + " -std=c++11 -O2 -fPIC -shared compiledForest.gen.cpp -o compiledForest.gen.so";
+	auto start = std::chrono::steady_clock::now();
+	if(std::system(compileCommand.c_str()) != 0){
+		std::cout << "unable to compile compiledForest.gen.cpp\n";
+		return 1;
+	}
+	std::chrono::duration<double> compileTime = std::chrono::steady_clock::now() - start;
+
+	void* library = dlopen("./compiledForest.gen.so", RTLD_NOW);
+	if(library == NULL){
+		std::cout << dlerror() << "\n";
+		return 1;
+	}
+	predictBatchFunction compiledPredictBatch = (predictBatchFunction)dlsym(library, "predictBatch");
+	if(compiledPredictBatch == NULL){
+		std::cout << dlerror() << "\n";
+		return 1;
+	}
+
+	std::vector<int> expected(numObs);
+	start = std::chrono::steady_clock::now();
+	forest.predictBatch(X.data(), numObs, numFeatures, true, expected.data());
+	std::chrono::duration<double> forestTime = std::chrono::steady_clock::now() - start;
+
+	std::vector<int> predictions(numObs);
+	start = std::chrono::steady_clock::now();
+	compiledPredictBatch(X.data(), numObs, numFeatures, true, predictions.data());
+	std::chrono::duration<double> compiledTime = std::chrono::steady_clock::now() - start;
+
+	std::vector<int> colMajorPredictions(numObs);
+	compiledPredictBatch(colMajorX.data(), numObs, numFeatures, false, colMajorPredictions.data());
+
+	int numDifferent = 0;
+	for(int i = 0; i < numObs; ++i){
+		numDifferent += predictions[i] != expected[i] || colMajorPredictions[i] != expected[i];
+	}
+
+	std::cout << "compile(s)\tpredictBatch(s)\tcompiled(s)\tdifferent\n";
+	std::cout << compileTime.count() << "\t" << forestTime.count() << "\t" << compiledTime.count() << "\t" << numDifferent << "\n";
+	dlclose(library);
+	return numDifferent ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+#include "../src/packedForest.h"
+#include "syntheticData.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+// Times binned forest prediction at several thread counts:
+//   ./predictScaling [numThreads ...]
+// predict is the one observation at a time path, where the threads split
+// the bins of a single observation and combine their votes.  predictBatch
+// splits the observations instead.  Defaults to 1, 8 and 32 threads.
+
+int main(int argc, char* argv[]) {
+	std::vector<int> threadCounts;
+	for(int i = 1; i < argc; ++i){
+		threadCounts.push_back(atoi(argv[i]));
+	}
+	if(threadCounts.empty()){
+		threadCounts = {1, 8, 32};
+	}
+
+	const int numObs = 100000;
+	const int numFeatures = 20;
+	const int numPredict = 20000;
+	const int numTrees = 128;
+
+	std::vector<double> X;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 11, X, Y);
+
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBase");
+	forest.setParameter("numTreesInForest", numTrees);
+	forest.setParameter("numTreeBins", numTrees);
+	forest.setParameter("numCores", threadCounts.back());
+	forest.setParameter("seed",-1661580697);
+	forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+
+	std::vector<double> observation(numFeatures);
+	std::vector<int> predictions(numPredict);
+	std::cout << "threads\tpredict(s)\tpredictBatch(s)\n";
+	for(int numThreads : threadCounts){
+		forest.setParameter("numCores", numThreads);
+
+		auto start = std::chrono::steady_clock::now();
+		for(int i = 0; i < numPredict; ++i){
+			observation.assign(X.begin()+(size_t)i*numFeatures, X.begin()+(size_t)(i+1)*numFeatures);
+			predictions[i] = forest.predict(observation);
+		}
+		std::chrono::duration<double> predictTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		forest.predictBatch(X.data(), numPredict, numFeatures, true, predictions.data());
+		std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - start;
+
+		std::cout << numThreads << "\t" << predictTime.count() << "\t" << batchTime.count() << "\n";
+	}
+}
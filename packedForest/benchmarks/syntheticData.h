@@ -0,0 +1,30 @@
+#ifndef syntheticData_h
+#define syntheticData_h
+#include <vector>
+#include <random>
+#include <cstddef>
+
+// Fills X (row major) and Y with numObs standard normal observations whose
+// class is whether X0 + X1*X2 > 0.  colMajorX, if given, gets a column major
+// copy of X.  Shared by the benchmarks so they time the same data.
+inline void makeSyntheticData(const int numObs, const int numFeatures, const int seed, std::vector<double>& X, std::vector<int>& Y, std::vector<double>* colMajorX = NULL)
+{
+	std::mt19937 eng(seed);
+	std::normal_distribution<double> dist;
+	X.resize((size_t)numObs*numFeatures);
+	Y.resize(numObs);
+	if(colMajorX != NULL){
+		colMajorX->resize(X.size());
+	}
+	for(int i = 0; i < numObs; ++i){
+		for(int j = 0; j < numFeatures; ++j){
+			X[(size_t)i*numFeatures+j] = dist(eng);
+			if(colMajorX != NULL){
+				(*colMajorX)[(size_t)j*numObs+i] = X[(size_t)i*numFeatures+j];
+			}
+		}
+		Y[i] = X[(size_t)i*numFeatures] + X[(size_t)i*numFeatures+1]*X[(size_t)i*numFeatures+2] > 0;
+	}
+}
+
+#endif //syntheticData_h
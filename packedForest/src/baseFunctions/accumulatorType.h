@@ -0,0 +1,25 @@
+#ifndef accumulatorType_h
+#define accumulatorType_h
+
+#include <cstdint>
+
+namespace fp {
+
+	/**
+	 * accumulatorType gives the type used to sum and compare feature values
+	 * stored as T.  Floating point data is summed in its own type while
+	 * uint8 data is summed in int so projections neither wrap nor round.
+	 */
+
+	template <typename T>
+		struct accumulatorType{
+			typedef T type;
+		};
+
+	template <>
+		struct accumulatorType<uint8_t>{
+			typedef int type;
+		};
+
+} //namespace fp
+#endif //accumulatorType_h
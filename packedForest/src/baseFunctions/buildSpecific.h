@@ -1,10 +1,63 @@
 #ifndef buildSpecific_h
 #define buildSpecific_h
 
+#include <cstddef>
+
 //Test show globalPrefetchSize >1 is beneficial.  >32 is detrimental.
 //This is architecture specific.
 const int globalPrefetchSize=32;
 
+//Histogram split mode places its cut points from this many sampled values
+//per bin.  Nodes no larger than the sample are split exactly.
+const int globalHistogramSamplesPerBin=8;
+
+//Adaptive sortWorkingSet: insertion sort below globalInsertionSortMax, radix
+//sort from globalRadixSortMin for 32 bit values, pdqsort otherwise.  64 bit
+//values need twice the radix passes and measured slower than pdqsort at all
+//sizes so they are only radix sorted when asked for.
+const int globalInsertionSortMax=24;
+const int globalRadixSortMin=4096;
+
+//With useNodeTasks the children of nodes at least this large are grown as
+//separate tasks.  Smaller subtrees stay with the task that reached them.
+const int globalNodeTaskMin=2048;
+
+//With useFeatureTasks the candidates of nodes at least this large are
+//evaluated by parallel tasks, each needing its own copy of the working set.
+const int globalFeatureTaskMin=4096;
+
+//Bins keep the values of the best projection found so far so the winning
+//split partitions without recomputing them.  This takes two values per
+//observation per bin; bins whose cache would exceed this many bytes
+//recompute the projection instead.  Nodes whose candidates average fewer
+//than globalProjectionCacheMinFeatures features recompute as well, saving
+//sparse projections measured slower than gathering them again.
+const size_t globalProjectionCacheMaxBytes=size_t(256)<<20;
+const int globalProjectionCacheMinFeatures=4;
+
+//Projections are summed for this many observations of a node at a time,
+//one feature at a time when the data is column major.
+const int globalProjectionBlockSize=256;
+
+//predictBatch hands the threads this many observations at a time.
+const int globalPredictBlockSize=64;
+
+//Binned forests predict batches a tile of observations at a time, the tile
+//passing through one bin after another.  Tiles are sized so the
+//observations, their votes and up to half of this cache size of bin fit in
+//this many bytes, an L2 cache.  This is architecture specific.
+const size_t globalPredictCacheBytes=size_t(1)<<20;
+const int globalPredictTileMin=16;
+const int globalPredictTileMax=4096;
+
+//Threads predicting one observation count votes in tallies padded to
+//whole cache lines so no two threads write to the same line.
+const int globalCacheLineSize=64;
+
+//Bins tally out of bag votes for this many observations at a time before
+//adding them to the forest's votes.
+const int globalOOBTallyBlockSize=4096;
+
 //use mm_prefetch for non GNU compilers
 #if (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_AMD64))) || defined(__INTEL_COMPILER)
 #include <xmmintrin.h>
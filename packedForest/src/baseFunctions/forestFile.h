@@ -0,0 +1,213 @@
+#ifndef forestFile_h
+#define forestFile_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "mappedFile.h"
+#include "../fpSingleton/dataset/binaryDataFormat.h"
+
+namespace fp {
+
+	/**
+	 * Saved forest format.  Every field is written in the byte order of
+	 * the machine that wrote the file; endianTag lets a reader detect a
+	 * mismatch.
+	 *
+	 *   offset  bytes  field
+	 *   0       8      magic "FPFOREST"
+	 *   8       4      format version
+	 *   12      4      endian tag 0x01020304
+	 *   16      4      X element type, as in binaryDataFormat.h
+	 *   20      4      number of classes
+	 *   24      4      number of features
+	 *   28      4      number of trees
+	 *   32      4      number of tree bins
+	 *   36      4      methodToUse
+	 *   40      4      image height
+	 *   44      4      image width
+	 *   48      4      useSummedAreaTables
+	 *   52      4      OOB accuracy (float)
+	 *   56      64     forest type, zero padded
+	 *   120     8      reserved, zero
+	 *
+	 * The forest type's own body follows the header as a sequence of
+	 * values and arrays.  Values and arrays start on 8 byte boundaries, an
+	 * array preceded by its uint64 element count.  Sections are arrays
+	 * that start on a page boundary so a loader can use them in place
+	 * from the mapped file.
+	 */
+
+	struct forestFileHeader{
+		char magic[8];
+		uint32_t version;
+		uint32_t endianTag;
+		uint32_t xType;
+		int32_t numClasses;
+		int32_t numFeatures;
+		int32_t numTrees;
+		int32_t numTreeBins;
+		int32_t methodToUse;
+		int32_t imageHeight;
+		int32_t imageWidth;
+		int32_t useSummedAreaTables;
+		float OOBAccuracy;
+		char forestType[64];
+		uint64_t reserved;
+	};
+
+	static_assert(sizeof(forestFileHeader) == 128, "forestFileHeader must be 128 bytes.");
+
+	const char forestFileMagic[8] = {'F','P','F','O','R','E','S','T'};
+	const uint32_t forestFileVersion = 1;
+	const uint32_t forestFileEndianTag = 0x01020304;
+	const uint64_t forestFileValueAlignment = 8;
+	const uint64_t forestFileSectionAlignment = 4096;
+
+
+	/**
+	 * forestFileWriter writes a forest file front to back.
+	 */
+
+	class forestFileWriter
+	{
+		protected:
+			std::ofstream forestFile;
+			uint64_t position;
+
+			inline void writeBytes(const void* bytes, uint64_t numBytes){
+				forestFile.write(static_cast<const char*>(bytes), numBytes);
+				position += numBytes;
+				if(!forestFile.good()){
+					throw std::runtime_error("Unable to write forest file." );
+				}
+			}
+
+			inline void padTo(uint64_t alignment){
+				static const std::vector<char> padding(forestFileSectionAlignment, 0);
+				writeBytes(padding.data(), roundUpToMultiple(position, alignment) - position);
+			}
+
+			template <typename X>
+				inline void writeArray(const X* values, size_t count, uint64_t alignment){
+					static_assert(std::is_trivially_copyable<X>::value, "forest files hold trivially copyable types.");
+					writeValue((uint64_t)count);
+					padTo(alignment);
+					writeBytes(values, count*sizeof(X));
+				}
+
+		public:
+			forestFileWriter(const std::string& fileName) : forestFile(fileName, std::ios::binary | std::ios::trunc), position(0){
+				if(!forestFile.good()){
+					throw std::runtime_error("Unable to open file." );
+				}
+			}
+
+			template <typename X>
+				inline void writeValue(const X& value){
+					static_assert(std::is_trivially_copyable<X>::value, "forest files hold trivially copyable types.");
+					padTo(forestFileValueAlignment);
+					writeBytes(&value, sizeof(X));
+				}
+
+			template <typename X>
+				inline void writeArray(const std::vector<X>& values){
+					writeArray(values.data(), values.size(), forestFileValueAlignment);
+				}
+
+			template <typename X>
+				inline void writeSection(const X* values, size_t count){
+					writeArray(values, count, forestFileSectionAlignment);
+				}
+	};
+
+
+	/**
+	 * forestFileReader maps a forest file and reads it front to back.
+	 * Arrays are returned as pointers into the mapping, which lives as
+	 * long as any holder of returnFile().
+	 */
+
+	class forestFileReader
+	{
+		protected:
+			std::shared_ptr<mappedFile> forestFile;
+			uint64_t position;
+
+			inline const char* readBytes(uint64_t numBytes, uint64_t alignment){
+				position = roundUpToMultiple(position, alignment);
+				if(position + numBytes > forestFile->returnSize()){
+					throw std::runtime_error("forest file is truncated." );
+				}
+				const char* bytes = forestFile->returnData() + position;
+				position += numBytes;
+				return bytes;
+			}
+
+			template <typename X>
+				inline const X* readArray(size_t& count, uint64_t alignment){
+					count = readValue<uint64_t>();
+					if(count > forestFile->returnSize()/sizeof(X)){
+						throw std::runtime_error("forest file is truncated." );
+					}
+					return reinterpret_cast<const X*>(readBytes(count*sizeof(X), alignment));
+				}
+
+		public:
+			forestFileReader(const std::string& fileName) : forestFile(std::make_shared<mappedFile>(fileName)), position(0){}
+
+			template <typename T>
+				inline forestFileHeader readHeader(){
+					forestFileHeader header;
+					if(forestFile->returnSize() < sizeof(forestFileHeader)){
+						throw std::runtime_error("file is not a saved forest." );
+					}
+					std::memcpy(&header, readBytes(sizeof(forestFileHeader), forestFileValueAlignment), sizeof(forestFileHeader));
+
+					if(std::memcmp(header.magic, forestFileMagic, sizeof(forestFileMagic)) != 0){
+						throw std::runtime_error("file is not a saved forest." );
+					}
+					if(header.endianTag != forestFileEndianTag){
+						throw std::runtime_error("saved forest was written with a different byte order." );
+					}
+					if(header.version != forestFileVersion){
+						throw std::runtime_error("unsupported saved forest version." );
+					}
+					if(header.xType != binaryElementType<T>::value){
+						throw std::runtime_error("saved forest element type does not match the forest data type." );
+					}
+					header.forestType[sizeof(header.forestType)-1] = '\0';
+					return header;
+				}
+
+			template <typename X>
+				inline X readValue(){
+					X value;
+					std::memcpy(&value, readBytes(sizeof(X), forestFileValueAlignment), sizeof(X));
+					return value;
+				}
+
+			template <typename X>
+				inline void readArray(std::vector<X>& values){
+					size_t count;
+					const X* first = readArray<X>(count, forestFileValueAlignment);
+					values.assign(first, first+count);
+				}
+
+			template <typename X>
+				inline const X* readSection(size_t& count){
+					return readArray<X>(count, forestFileSectionAlignment);
+				}
+
+			inline std::shared_ptr<mappedFile> returnFile(){
+				return forestFile;
+			}
+	};
+
+} //namespace fp
+#endif //forestFile_h
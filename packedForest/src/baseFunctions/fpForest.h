@@ -1,9 +1,12 @@
 #ifndef fpForest_h
 #define fpForest_h
 
-#include "../fpSingleton/fpSingleton.h"
+#include "../fpSingleton/fpContext.h"
 #include <string>
 #include <memory>
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
 
 #if defined(ENABLE_OPENMP)
 #include <omp.h>
@@ -22,83 +25,82 @@ namespace fp {
 		class fpForest{
 
 			protected:
+				fpContext context;
 				std::unique_ptr<fpForestBase<T> > forest;
 				float OOBaccuracy = 0;
 
 				void loadData(){
-					fpSingleton::getSingleton().loadData();
+					context.loadData<T>();
 				}
 
 				void loadData(const T* Xmat, const int* Yvec, int numObs, int numFeatures){
-					fpSingleton::getSingleton().loadData(Xmat,Yvec,numObs,numFeatures);
+					context.loadData(Xmat,Yvec,numObs,numFeatures);
 				}
 
 
 				void loadTestData(){
-					fpSingleton::getSingleton().loadTestData();
+					context.loadTestData<T>();
 				}
 
 				void deleteData(){
-					fpSingleton::getSingleton().deleteData();
+					context.deleteData();
 				}
 
 				void deleteTestData(){
-					fpSingleton::getSingleton().deleteTestData();
+					context.deleteTestData();
 				}
 
 
 				inline void setFunctionPointers(){
-					;//fpSingleton::getSingleton().setFunctionPointers();
+					;//context.setFunctionPointers();
 				}
 
 				inline void initializeForestType(){
-					forest = forestFactory<T>::setForestType(fpSingleton::getSingleton().returnForestType());
+					forest = forestFactory<T>::setForestType(context.returnForestType(), context);
 				}
 
 				inline void setDataDependentParameters(){
-					fpSingleton::getSingleton().setDataDependentParameters();
+					context.setDataDependentParameters();
 				}
 
 				inline void checkDataDependentParameters(){
-					fpSingleton::getSingleton().checkDataDependentParameters();
+					context.checkDataDependentParameters();
 				}
 
 			public:
 
 				fpForest(){}
-				~fpForest(){
-				fpSingleton::getSingleton().resetSingleton();
-				}
+				~fpForest(){}
 
 				inline void setParameter(const std::string& parameterName, const std::string& parameterValue){
-					fpSingleton::getSingleton().setParameter(parameterName, parameterValue);	
+					context.setParameter(parameterName, parameterValue);	
 				}
 
 
 				inline void setParameter(const std::string& parameterName, const double parameterValue){
-					fpSingleton::getSingleton().setParameter(parameterName, parameterValue);	
+					context.setParameter(parameterName, parameterValue);	
 				}
 
 
 				inline void setParameter(const std::string& parameterName, const int parameterValue){
-					fpSingleton::getSingleton().setParameter(parameterName, parameterValue);	
+					context.setParameter(parameterName, parameterValue);	
 				}
 
 
 				inline void printParameters(){
-					fpSingleton::getSingleton().printAllParameters();
+					context.printAllParameters();
 				}
 
 
 				inline void printForestType(){
-					fpSingleton::getSingleton().printForestType();
+					context.printForestType();
 				}
 
 
 				inline void setNumberOfThreads(){
 					omp_set_dynamic(0);     // Explicitly disable dynamic teams
-					omp_set_num_threads(fpSingleton::getSingleton().returnNumThreads());
-					std::cout << "\n" << fpSingleton::getSingleton().returnNumThreads() << " thread was set\n";
+					omp_set_num_threads(context.returnNumThreads());
+					std::cout << "\n" << context.returnNumThreads() << " thread was set\n";
 				}
 
 
@@ -138,6 +140,87 @@ namespace fp {
 					return forest->predictClass(observation);
 				}
 
+				//predicts every row of the numObservations by numFeatures matrix X
+				//without copying it.  X is row major unless rowMajor is false.
+				inline void predictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions){
+					if(numFeatures != context.returnNumFeatures()){
+						throw std::runtime_error("predictBatch was given a different number of features than the forest was grown with.");
+					}
+					forest->predictBatch(X, numObservations, numFeatures, rowMajor, predictions);
+				}
+
+				//writes the grown forest to fileName in the format of forestFile.h.
+				inline void save(const std::string& fileName){
+					if(!forest){
+						throw std::runtime_error("save needs a grown forest.");
+					}
+					if(context.returnForestType().size() >= sizeof(forestFileHeader().forestType)){
+						throw std::runtime_error("forest type name is too long to save.");
+					}
+					forestFileHeader header;
+					std::memset(&header, 0, sizeof(header));
+					std::memcpy(header.magic, forestFileMagic, sizeof(forestFileMagic));
+					header.version = forestFileVersion;
+					header.endianTag = forestFileEndianTag;
+					header.xType = binaryElementType<T>::value;
+					header.numClasses = context.returnNumClasses();
+					header.numFeatures = context.returnNumFeatures();
+					header.numTrees = context.returnNumTrees();
+					header.numTreeBins = context.returnNumTreeBins();
+					header.methodToUse = context.returnMethodToUse();
+					header.imageHeight = context.returnImageHeight();
+					header.imageWidth = context.returnImageWidth();
+					header.useSummedAreaTables = context.returnUseSummedAreaTables();
+					header.OOBAccuracy = OOBaccuracy;
+					std::memcpy(header.forestType, context.returnForestType().data(), context.returnForestType().size());
+
+					forestFileWriter forestFile(fileName);
+					forestFile.writeValue(header);
+					forest->saveForest(forestFile);
+				}
+
+
+				//replaces this forest with the one saved in fileName.  Binned
+				//forests predict from the mapped file in place, so processes
+				//loading the same file share one copy of it.  Parameters that
+				//do not change the model, like numCores, keep their values.
+				inline void load(const std::string& fileName){
+					forestFileReader forestFile(fileName);
+					forestFileHeader header = forestFile.readHeader<T>();
+
+					context.setParameter("forestType", std::string(header.forestType));
+					context.setParameter("numTreesInForest", header.numTrees);
+					context.setParameter("numTreeBins", header.numTreeBins);
+					context.setParameter("methodToUse", header.methodToUse);
+					context.setParameter("imageHeight", header.imageHeight);
+					context.setParameter("imageWidth", header.imageWidth);
+					context.setParameter("useSummedAreaTables", header.useSummedAreaTables);
+					context.setNumClasses(header.numClasses);
+					context.setNumFeatures(header.numFeatures);
+					setDataDependentParameters();
+					initializeForestType();
+					forest->loadForest(forestFile);
+					OOBaccuracy = header.OOBAccuracy;
+				}
+
+				//writes the grown forest as a C++ translation unit defining
+				//extern "C" void functionName(const T* X, int numObservations,
+				//int numFeatures, bool rowMajor, int* predictions), which
+				//predicts as predictBatch does.  Binned forests only.
+				inline void writeSource(const std::string& fileName, const std::string& functionName){
+					if(!forest){
+						throw std::runtime_error("writeSource needs a grown forest.");
+					}
+					std::ofstream source(fileName, std::ios::trunc);
+					if(!source.good()){
+						throw std::runtime_error("Unable to open file." );
+					}
+					forest->writeSource(source, functionName);
+					if(!source.good()){
+						throw std::runtime_error("Unable to write source file." );
+					}
+				}
+
 				inline void updateOOB(){
 					OOBaccuracy = forest->reportOOB();
 				}
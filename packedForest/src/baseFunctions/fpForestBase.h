@@ -8,12 +8,38 @@
 #include <ctime>
 #include <chrono>
 #include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <ostream>
+#include <stdexcept>
+#include "buildSpecific.h"
+#include "forestFile.h"
 
 namespace fp{
 
 	template <typename T>
 		class fpForestBase
 		{
+			protected:
+				//predictBatch for forests that predict from a std::vector.  Each
+				//thread copies its rows into its own vector.
+				inline void predictBatchByRow(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions, int numThreads){
+					const int numBlocks = (numObservations+globalPredictBlockSize-1)/globalPredictBlockSize;
+#pragma omp parallel num_threads(numThreads)
+					{
+						std::vector<T> observation(numFeatures);
+#pragma omp for schedule(dynamic)
+						for(int block = 0; block < numBlocks; ++block){
+							const int blockEnd = std::min(numObservations, (block+1)*globalPredictBlockSize);
+							for(int i = block*globalPredictBlockSize; i < blockEnd; ++i){
+								for(int j = 0; j < numFeatures; ++j){
+									observation[j] = rowMajor ? X[(size_t)i*numFeatures+j] : X[(size_t)j*numObservations+i];
+								}
+								predictions[i] = predictClass(observation);
+							}
+						}
+					}
+				}
 
 			public:
 
@@ -28,7 +54,19 @@ namespace fp{
 				virtual int predictClass(std::vector<T>& observation) = 0;
 				virtual std::vector<int> predictClassPost(std::vector<T>& observation) = 0;
 				virtual int predictClass(const T* observation) = 0;
+				//predicts the numObservations rows of X, stored row major or
+				//column major, into predictions.
+				virtual void predictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions) = 0;
 				virtual float reportOOB() = 0; //TODO: JLP, finish this implementation.
+				//write the grown forest after the header of a forest file, and
+				//read it back in a forest whose context the header restored.
+				virtual void saveForest(forestFileWriter& forestFile) = 0;
+				virtual void loadForest(forestFileReader& forestFile) = 0;
+				//write the forest as C++ source defining functionName, an
+				//extern "C" function with the signature of predictBatch.
+				virtual void writeSource(std::ostream& source, const std::string& functionName){
+					throw std::runtime_error("writeSource is only implemented for binned forests.");
+				}
 				virtual std::map<std::pair<int, int>, double> returnPairMat() = 0;
 		};
 
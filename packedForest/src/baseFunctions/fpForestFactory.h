@@ -2,6 +2,7 @@
 #define fpForestFactory_h
 
 #include <string>
+#include <cstdint>
 #include "fpForestBase.h"
 #include "weightedFeature.h"
 #include "../forestTypes/basicForests/rerf/fpRerFBase.h"
@@ -16,26 +17,49 @@ namespace fp{
 		class forestFactory
 		{
 			public:
-				static std::unique_ptr<fpForestBase<T> > setForestType(const std::string& parameterName){
+				static std::unique_ptr<fpForestBase<T> > setForestType(const std::string& parameterName, fpContext& forestContext){
 					if(parameterName == "rfBase"){
-						return std::unique_ptr<fpForestBase<T> >{new fpForestClassificationBase<T>};
+						return std::unique_ptr<fpForestBase<T> >{new fpForestClassificationBase<T>(forestContext)};
 					}else if(parameterName == "rerf"){
-						return std::unique_ptr<fpForestBase<T> >{new fpRerFBase<T>};
+						return std::unique_ptr<fpForestBase<T> >{new fpRerFBase<T>(forestContext)};
 					}else if(parameterName == "urf"){
-						return std::unique_ptr<fpForestBase<T> >{new fpURFBase<T>};
+						return std::unique_ptr<fpForestBase<T> >{new fpURFBase<T>(forestContext)};
 					}else if(parameterName == "urerf"){
-						return std::unique_ptr<fpForestBase<T> >{new fpURerFBase<T>};
+						return std::unique_ptr<fpForestBase<T> >{new fpURerFBase<T>(forestContext)};
 					}else if(parameterName == "binnedBase"){
-						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,int>};
+						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,int>(forestContext)};
 					}else if(parameterName == "binnedBaseRerF"){
-						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,std::vector<int> >};
+						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,std::vector<int> >(forestContext)};
 					}else if(parameterName == "binnedBaseTern"){
-						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,weightedFeature >};
+						return std::unique_ptr<fpForestBase<T> >{new binnedBase<T,weightedFeature >(forestContext)};
 					}else{
 						throw std::runtime_error("Unimplemented forest type chosen." );
 						return NULL;
 					}
 				}
 		};
+
+
+	/**
+	 * uint8 data is only grown by the binned forests, which accumulate
+	 * projections in int.
+	 */
+	template <>
+		class forestFactory<uint8_t>
+		{
+			public:
+				static std::unique_ptr<fpForestBase<uint8_t> > setForestType(const std::string& parameterName, fpContext& forestContext){
+					if(parameterName == "binnedBase"){
+						return std::unique_ptr<fpForestBase<uint8_t> >{new binnedBase<uint8_t,int>(forestContext)};
+					}else if(parameterName == "binnedBaseRerF"){
+						return std::unique_ptr<fpForestBase<uint8_t> >{new binnedBase<uint8_t,std::vector<int> >(forestContext)};
+					}else if(parameterName == "binnedBaseTern"){
+						return std::unique_ptr<fpForestBase<uint8_t> >{new binnedBase<uint8_t,weightedFeature >(forestContext)};
+					}else{
+						throw std::runtime_error("Forest type does not support uint8 data." );
+						return NULL;
+					}
+				}
+		};
 }//namespace fp
 #endif //fpForestFactory_h
@@ -0,0 +1,108 @@
+#ifndef mappedFile_h
+#define mappedFile_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstddef>
+
+#if defined(_WIN32)
+#define FP_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fp {
+
+	/**
+	 * mappedFile gives read only access to the full contents of a file.
+	 * On POSIX systems the file is memory mapped so pages are brought in
+	 * by the OS as they are touched.  Where mmap is not available the
+	 * file is read into a buffer instead.
+	 */
+
+	class mappedFile
+	{
+		private:
+			const char* fileData;
+			size_t fileSize;
+#ifdef FP_NO_MMAP
+			std::vector<char> fileBuffer;
+#else
+			void* mapping;
+#endif
+
+			mappedFile(const mappedFile&);
+			mappedFile& operator=(const mappedFile&);
+
+		public:
+			mappedFile(const std::string& fileName) : fileData(NULL), fileSize(0){
+#ifdef FP_NO_MMAP
+				std::ifstream fileHandle(fileName, std::ios::binary | std::ios::ate);
+				if(!fileHandle.good()){
+					throw std::runtime_error("Unable to open file." );
+				}
+				fileSize = fileHandle.tellg();
+				fileHandle.seekg(0, std::ios::beg);
+				fileBuffer.resize(fileSize);
+				if(fileSize && !fileHandle.read(fileBuffer.data(), fileSize)){
+					throw std::runtime_error("Unable to read file." );
+				}
+				fileData = fileBuffer.data();
+#else
+				mapping = NULL;
+				int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+				if(fileDescriptor == -1){
+					throw std::runtime_error("Unable to open file." );
+				}
+				struct stat fileStats;
+				if(fstat(fileDescriptor, &fileStats) == -1){
+					close(fileDescriptor);
+					throw std::runtime_error("Unable to open file." );
+				}
+				fileSize = fileStats.st_size;
+				if(fileSize){
+					mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+					if(mapping == MAP_FAILED){
+						mapping = NULL;
+						close(fileDescriptor);
+						throw std::runtime_error("Unable to map file." );
+					}
+					fileData = static_cast<const char*>(mapping);
+				}
+				close(fileDescriptor);
+#endif
+			}
+
+			~mappedFile(){
+#ifndef FP_NO_MMAP
+				if(mapping != NULL){
+					munmap(mapping, fileSize);
+				}
+#endif
+			}
+
+			//hint that the file will be read front to back.
+			inline void adviseSequential(){
+#ifndef FP_NO_MMAP
+				if(mapping != NULL){
+					madvise(mapping, fileSize, MADV_SEQUENTIAL);
+				}
+#endif
+			}
+
+			inline const char* returnData() const{
+				return fileData;
+			}
+
+			inline size_t returnSize() const{
+				return fileSize;
+			}
+	};
+
+} //namespace fp
+#endif //mappedFile_h
@@ -0,0 +1,113 @@
+#ifndef radixSort_h
+#define radixSort_h
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+namespace fp {
+
+	/**
+	 * radixSortKey maps a value to an unsigned integer with the same
+	 * ordering so values can be sorted a digit at a time.  Floating point
+	 * values flip every bit when negative and only the sign bit otherwise;
+	 * signed integers flip the sign bit.
+	 */
+
+	template <typename V>
+		struct radixSortKey;
+
+	template <>
+		struct radixSortKey<float>{
+			typedef uint32_t type;
+			static inline type toKey(const float value){
+				uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+			}
+		};
+
+	template <>
+		struct radixSortKey<double>{
+			typedef uint64_t type;
+			static inline type toKey(const double value){
+				uint64_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+			}
+		};
+
+	template <>
+		struct radixSortKey<int>{
+			typedef uint32_t type;
+			static inline type toKey(const int value){
+				return (uint32_t)value ^ 0x80000000u;
+			}
+		};
+
+
+	/**
+	 * LSD radix sort of records by returnFeatureVal(), eleven bits per pass.
+	 * All digit histograms are built in one read of the data and passes
+	 * where every record shares the same digit are skipped, so a node whose
+	 * values share their high bits costs fewer passes.  buffer is scratch
+	 * space and is grown to the size of the range.  The sort is stable.
+	 */
+	template <typename Iter>
+		inline void radixSort(Iter begin, Iter end, std::vector<typename std::iterator_traits<Iter>::value_type>& buffer){
+			typedef typename std::iterator_traits<Iter>::value_type R;
+			typedef typename std::remove_reference<decltype(begin->returnFeatureVal())>::type V;
+			typedef typename radixSortKey<V>::type K;
+			const int digitBits = 11;
+			const int numDigits = 1 << digitBits;
+			const K digitMask = numDigits - 1;
+			const int numPasses = (8*sizeof(K) + digitBits - 1)/digitBits;
+
+			const size_t numRecords = end - begin;
+			if(numRecords < 2){
+				return;
+			}
+			buffer.resize(numRecords);
+
+			std::vector<size_t> counts(numPasses*numDigits, 0);
+			for(Iter it = begin; it != end; ++it){
+				K key = radixSortKey<V>::toKey(it->returnFeatureVal());
+				for(int pass = 0; pass < numPasses; ++pass){
+					++counts[pass*numDigits + ((key >> (digitBits*pass)) & digitMask)];
+				}
+			}
+
+			R* source = &*begin;
+			R* destination = buffer.data();
+			for(int pass = 0; pass < numPasses; ++pass){
+				size_t* passCounts = &counts[pass*numDigits];
+				K firstDigit = (radixSortKey<V>::toKey(source->returnFeatureVal()) >> (digitBits*pass)) & digitMask;
+				if(passCounts[firstDigit] == numRecords){
+					continue;
+				}
+
+				size_t offset = 0;
+				for(int digit = 0; digit < numDigits; ++digit){
+					size_t digitCount = passCounts[digit];
+					passCounts[digit] = offset;
+					offset += digitCount;
+				}
+
+				for(size_t i = 0; i < numRecords; ++i){
+					K digit = (radixSortKey<V>::toKey(source[i].returnFeatureVal()) >> (digitBits*pass)) & digitMask;
+					destination[passCounts[digit]++] = source[i];
+				}
+				std::swap(source, destination);
+			}
+
+			if(source != &*begin){
+				std::copy(source, source+numRecords, begin);
+			}
+		}
+
+} //namespace fp
+#endif //radixSort_h
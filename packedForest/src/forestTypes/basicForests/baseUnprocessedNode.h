@@ -11,6 +11,7 @@ namespace fp{
 	template <typename T> //
 		class baseUnprocessedNode{
 			protected:
+				fpContext* context;
 				int parentID;
 				int depth;
 				double nodeImpurity; //lower impurity is better
@@ -25,11 +26,11 @@ namespace fp{
 				std::vector<int> labelHolder;
 				
 			public:
-				baseUnprocessedNode(int numObsForRoot):  parentID(0), depth(0), isLeftNode(true){
-					obsIndices = new stratifiedInNodeClassIndices(numObsForRoot);
+				baseUnprocessedNode(fpContext& forestContext, int numObsForRoot): context(&forestContext), parentID(0), depth(0), isLeftNode(true){
+					obsIndices = new stratifiedInNodeClassIndices(forestContext, numObsForRoot);
 				}
 
-				baseUnprocessedNode(int parentID, int dep, bool isLeft): parentID(parentID), depth(dep), isLeftNode(isLeft){}
+				baseUnprocessedNode(fpContext& forestContext, int parentID, int dep, bool isLeft): context(&forestContext), parentID(parentID), depth(dep), isLeftNode(isLeft){}
 
 				virtual ~baseUnprocessedNode(){}
 				
@@ -113,11 +114,11 @@ namespace fp{
 				inline void loadLabelHolder(){
 					if(obsIndices->useBin()){
 						for(int i =0; i < obsIndices->returnBinnedSize(); ++i){
-							labelHolder[i] = fpSingleton::getSingleton().returnLabel(obsIndices->returnBinnedInSample(i));
+							labelHolder[i] = context->returnLabel(obsIndices->returnBinnedInSample(i));
 						}
 					}else{
 						for(int i =0; i < obsIndices->returnInSampleSize(); ++i){
-							labelHolder[i] = fpSingleton::getSingleton().returnLabel(obsIndices->returnInSample(i));
+							labelHolder[i] = context->returnLabel(obsIndices->returnInSample(i));
 						}
 					}
 				}
@@ -127,20 +128,20 @@ namespace fp{
 					 inline void loadFeatureHolder(){
 					 if(obsIndices->useBin()){
 					 for(int q=0; q<obsIndices->returnBinnedSize(); q++){
-					 fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),obsIndices->returnBinnedInSample(q));
+					 context->prefetchFeatureVal<T>(featuresToTry.back(),obsIndices->returnBinnedInSample(q));
 					 }
 
 					 for(int i =0; i < obsIndices->returnBinnedSize(); ++i){
-					 featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),obsIndices->returnBinnedInSample(i));
+					 featureHolder[i] = context->returnFeatureVal<T>(featuresToTry.back(),obsIndices->returnBinnedInSample(i));
 					 }
 					 }else{
 
 					 for(int q=0; q<obsIndices->returnInSampleSize(); q++){
-					 fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),obsIndices->returnInSample(q));
+					 context->prefetchFeatureVal<T>(featuresToTry.back(),obsIndices->returnInSample(q));
 					 }
 
 					 for(int i =0; i < obsIndices->returnInSampleSize(); ++i){
-					 featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),obsIndices->returnInSample(i));
+					 featureHolder[i] = context->returnFeatureVal<T>(featuresToTry.back(),obsIndices->returnInSample(i));
 					 }
 					 }
 					 }
@@ -181,7 +182,7 @@ namespace fp{
 					 std::cout << "found it\n";
 					 exit(1);
 					 }
-					 double featureVal = fpSingleton::getSingleton().returnFeatureVal(featureNum,inIndex);
+					 double featureVal = context->returnFeatureVal<T>(featureNum,inIndex);
 					 double splitVal = bestSplitInfo.returnSplitValue();
 					 if(featureVal < splitVal ){
 					 return true;
@@ -198,8 +199,8 @@ namespace fp{
 					 delete rightIndices;
 					 }
 
-					 leftIndices = new stratifiedInNodeClassIndices();
-					 rightIndices = new stratifiedInNodeClassIndices();
+					 leftIndices = new stratifiedInNodeClassIndices(*context);
+					 rightIndices = new stratifiedInNodeClassIndices(*context);
 
 					 int lNum =0;
 					 int rNum =0;
@@ -228,7 +229,7 @@ namespace fp{
 
 					 inline void findBestSplit(){
 				//timeLogger logTime;
-				fpSplit<T> findSplit(labelHolder); //This is done twice
+				fpSplit<T> findSplit(labelHolder, context->returnNumClasses()); //This is done twice
 				while(!featuresToTry.empty()){
 				//logTime.startGiniTimer();
 				loadFeatureHolder();
@@ -249,7 +250,7 @@ namespace fp{
 					if(nodeImpurity==0){
 						return labelHolder[0];
 					} else {
-						classTotals findMaxClass;
+						classTotals findMaxClass(context->returnNumClasses());
 						findMaxClass.findNumClasses(labelHolder);
 						return findMaxClass.returnLargestClass();
 					}
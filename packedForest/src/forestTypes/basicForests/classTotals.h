@@ -2,18 +2,23 @@
 #define classTotals_h
 
 #include <vector>
+#include <cstdint>
+#include <algorithm>
 
 namespace fp{
 
+	//impurity is n - sum_i c_i^2/n with the sum of squares kept up to date
+	//as items move, so a split scan pays O(1) per boundary.
 	class classTotals{
 		protected:
 			int maxClass;
 			int totalNumObj;
+			int64_t sumClassTotalsSquared;
 			double impurity;
 			std::vector<int> classVec;
 
 		public:
-			classTotals() : maxClass(-1), totalNumObj(0), impurity(-1), classVec(fpSingleton::getSingleton().returnNumClasses(),0){}
+			classTotals(const int numClasses) : maxClass(-1), totalNumObj(0), sumClassTotalsSquared(0), impurity(-1), classVec(numClasses,0){}
 
 			inline int returnLargestClass(){
 				int largestClass=-1; 
@@ -32,8 +37,7 @@ namespace fp{
 					if(i>maxClass){
 						maxClass = i;
 					}
-					++classVec[i];
-					++totalNumObj;
+					incrementClass(i);
 				}
 						classVec.resize(maxClass+1);
 			}
@@ -49,6 +53,7 @@ namespace fp{
 			inline void setClassVecSize(int newSize){
 				classVec.resize(newSize);
 				std::fill(classVec.begin(), classVec.end(), 0.0);
+				sumClassTotalsSquared = 0;
 			}
 
 			inline int returnClassVecSize(){
@@ -56,32 +61,19 @@ namespace fp{
 			}
 
 			inline double calcAndReturnImpurity(){
-				if(false){ //use gini impurity
-					int sumClassTotalsSquared = 0;
-					for(auto i : classVec){
-						sumClassTotalsSquared+=i*i;
-					}
-					return 1.0-double(sumClassTotalsSquared)/double(totalNumObj*totalNumObj);
-				}else{ //use what is this?
-					double impSum = 0;
-					double classPercent;
-					for(auto i : classVec){
-						classPercent = double(i)/double(totalNumObj);
-
-						impSum += double(i)*(1.0-classPercent);
-					}
-					return impSum;
-				}
+				return totalNumObj ? totalNumObj - double(sumClassTotalsSquared)/double(totalNumObj) : 0.0;
 			}
 
 
 			inline void decrementClass(int classNum){
+				sumClassTotalsSquared -= 2*(int64_t)classVec[classNum] - 1;
 				--classVec[classNum];
 				--totalNumObj;
 			}
 
 
 			inline void incrementClass(int classNum){
+				sumClassTotalsSquared += 2*(int64_t)classVec[classNum] + 1;
 				++classVec[classNum];
 				++totalNumObj;
 			}
@@ -90,6 +82,7 @@ namespace fp{
 			inline void resetClassTotals(){
 				std::fill(classVec.begin(), classVec.end(), 0);
 				totalNumObj=0;
+				sumClassTotalsSquared=0;
 			}
 	};
 
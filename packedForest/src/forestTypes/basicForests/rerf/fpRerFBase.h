@@ -17,6 +17,7 @@ namespace fp {
 		class fpRerFBase : public fpForestBase<T>
 	{
 		protected:
+			fpContext* context;
 			std::vector<rerfTree<T> > trees;
 			int numCorrect = 0;
 			int numOOB = 0;
@@ -24,6 +25,7 @@ namespace fp {
 			std::map<std::pair<int, int>, double> pairMat;
 		public:
 
+			fpRerFBase(fpContext& forestContext) : context(&forestContext){}
 			~fpRerFBase(){}
 
 			fpDisplayProgress printProgress;
@@ -32,13 +34,13 @@ namespace fp {
 			}
 
 			inline void changeForestSize(){
-				trees.resize(fpSingleton::getSingleton().returnNumTrees());
+				trees.resize(context->returnNumTrees(), rerfTree<T>(*context));
 			}
 
 			inline void growTrees(){
 
-				//fpSingleton::getSingleton().printXValues();
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
+				//context->printXValues();
+#pragma omp parallel for num_threads(context->returnNumThreads())
 				for(int i = 0; i < (int)trees.size(); ++i){
 					printProgress.displayProgress(i);
 					trees[i].growTree();
@@ -54,7 +56,7 @@ namespace fp {
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes. returnOOBvotes is an n x 2 vector with
@@ -84,7 +86,7 @@ namespace fp {
 					// Tally the number of correct predictions.
 					// i.first is the observation index.
 					// i.second is the predicted class.
-					if(fpSingleton::getSingleton().returnLabel(i.first) == i.second){
+					if(context->returnLabel(i.first) == i.second){
 						numCorrect++;
 					}
 				}
@@ -107,7 +109,7 @@ namespace fp {
 				int totalLeafDepth=0;
 
 				int tempMaxDepth;
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					tempMaxDepth = trees[i].returnMaxDepth();
 					maxDepth = ((maxDepth < tempMaxDepth) ? tempMaxDepth : maxDepth);
 
@@ -128,7 +130,7 @@ namespace fp {
 
 				std::cout << "max depth: " << treeStats["maxDepth"] << "\n";
 				std::cout << "avg depth: " << float(treeStats["totalLeafDepth"])/float(treeStats["totalLeafNodes"]) << "\n";
-				std::cout << "avg num leaf nodes per tree: " << treeStats["totalLeafNodes"]/fpSingleton::getSingleton().returnNumTrees() << "\n";
+				std::cout << "avg num leaf nodes per tree: " << treeStats["totalLeafNodes"]/context->returnNumTrees() << "\n";
 				std::cout << "num leaf nodes: " << treeStats["totalLeafNodes"] << "\n";
 				std::cout << "OOB Accuracy: " << treeStats["OOBaccuracy"] << "\n";
 			}
@@ -144,12 +146,12 @@ namespace fp {
 			}
 
 			inline int predictClass(int observationNumber){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observationNumber)];
 				}
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -158,12 +160,12 @@ namespace fp {
 			}
 
 			inline int predictClass(std::vector<T>& observation){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -172,9 +174,35 @@ namespace fp {
 			}
 
 
+			inline void predictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions){
+				this->predictBatchByRow(X, numObservations, numFeatures, rowMajor, predictions, context->returnNumThreads());
+			}
+
+
+			inline void saveForest(forestFileWriter& forestFile){
+				forestFile.writeValue((int32_t)trees.size());
+				for(auto& tree : trees){
+					tree.saveTree(forestFile);
+				}
+			}
+
+
+			inline void loadForest(forestFileReader& forestFile){
+				const int numTrees = forestFile.readValue<int32_t>();
+				if(numTrees != context->returnNumTrees()){
+					throw std::runtime_error("saved forest has the wrong number of trees.");
+				}
+				trees.clear();
+				trees.resize(numTrees, rerfTree<T>(*context));
+				for(auto& tree : trees){
+					tree.loadTree(forestFile);
+				}
+			}
+
+
 			inline std::vector<int> predictClassPost(std::vector<T>& observation){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 				return classTally;
@@ -183,12 +211,12 @@ namespace fp {
 
 inline int predictClass(const T* observation){
 	/*
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -205,11 +233,11 @@ inline std::map<std::pair<int, int>, double> returnPairMat(){
 				int numTried = 0;
 				int numWrong = 0;
 
-				for (int i = 0; i <fpSingleton::getSingleton().returnNumObservations();i++){
+				for (int i = 0; i <context->returnNumObservations();i++){
 					++numTried;
 					int predClass = predictClass(i);
 
-					if(predClass != fpSingleton::getSingleton().returnTestLabel(i)){
+					if(predClass != context->returnTestLabel(i)){
 						++numWrong;
 					}
 				}
@@ -229,7 +257,7 @@ inline std::map<std::pair<int, int>, double> returnPairMat(){
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes. returnOOBvotes is an n x 2 vector with
@@ -255,8 +283,8 @@ inline std::map<std::pair<int, int>, double> returnPairMat(){
 
 				for(auto& i : oobIndices){
 					std::vector<T> tmp;
-					for(int j = 0; j < fpSingleton::getSingleton().returnNumFeatures(); j++){
-						tmp.push_back(fpSingleton::getSingleton().returnFeatureVal(j, i));
+					for(int j = 0; j < context->returnNumFeatures(); j++){
+						tmp.push_back(context->returnFeatureVal<T>(j, i));
 					}
 					dataValues.push_back(tmp);
 				}
@@ -269,7 +297,7 @@ inline std::map<std::pair<int, int>, double> returnPairMat(){
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes.
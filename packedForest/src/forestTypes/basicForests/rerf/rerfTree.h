@@ -1,9 +1,12 @@
 #ifndef rerfTree_h
 #define rerfTree_h
 #include "../../../baseFunctions/fpBaseNode.h"
+#include "../../../baseFunctions/forestFile.h"
 #include "unprocessedRerFNode.h"
 #include <vector>
 #include <assert.h>
+#include <numeric>
+#include <algorithm>
 
 namespace fp{
 
@@ -11,26 +14,27 @@ namespace fp{
 		class rerfTree
 		{
 			protected:
+				fpContext* context;
 				float totalOOB;
 				std::vector<std::vector<int> > indexAndVote;
 				std::vector< fpBaseNode<T, std::vector<int> > > tree;
 				std::vector< unprocessedRerFNode<T> > nodeQueue;
 
 			public:
-				rerfTree() : totalOOB(0){}
+				rerfTree(fpContext& forestContext) : context(&forestContext), totalOOB(0){}
 
 				void loadFirstNode(){
-					nodeQueue.emplace_back(fpSingleton::getSingleton().returnNumObservations());
+					nodeQueue.emplace_back(*context, context->returnNumObservations());
 				}
 
 				inline bool shouldProcessNode(){
 					if(nodeQueue.back().returnNodeImpurity()==0){
 						return false;
 					}
-					if(nodeQueue.back().returnInSampleSize() <= fpSingleton::getSingleton().returnMinParent()){
+					if(nodeQueue.back().returnInSampleSize() <= context->returnMinParent()){
 						return false;
 					}
-					if(nodeQueue.back().returnDepth() >= fpSingleton::getSingleton().returnMaxDepth()){
+					if(nodeQueue.back().returnDepth() >= context->returnMaxDepth()){
 						return false;
 					}
 					return true;
@@ -154,10 +158,10 @@ namespace fp{
 
 					nodeQueue.pop_back();
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isLeftNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isLeftNode());
 					nodeQueue.back().loadIndices(leftIndices);
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isRightNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isRightNode());
 					nodeQueue.back().loadIndices(rightIndices);
 				}
 
@@ -211,7 +215,7 @@ namespace fp{
 					while(tree[currNode].isInternalNode()){
 						featureVal = 0;
 						for(auto featureNumber : tree[currNode].returnFeatureNumber()){
-							featureVal += fpSingleton::getSingleton().returnTestFeatureVal(featureNumber,observationNum);
+							featureVal += context->returnTestFeatureVal<T>(featureNumber,observationNum);
 						}
 						currNode = tree[currNode].fpBaseNode<T, std::vector<int> >::nextNode(featureVal);
 					}
@@ -235,6 +239,104 @@ inline int predictObservation(const T* observation){
 					return tree[currNode].returnClass();
 				}
 
+				//a tree is saved as one array per node field, the features of
+				//every node concatenated after their counts.
+				inline void saveTree(forestFileWriter& forestFile){
+					std::vector<T> cutValues(tree.size());
+					std::vector<int> lefts(tree.size());
+					std::vector<int> rights(tree.size());
+					std::vector<int> depths(tree.size());
+					std::vector<int> featureCounts(tree.size());
+					std::vector<int> features;
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						featureCounts[i] = tree[i].returnFeatureNumber().size();
+						features.insert(features.end(), tree[i].returnFeatureNumber().begin(), tree[i].returnFeatureNumber().end());
+					}
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						cutValues[i] = tree[i].returnCutValue();
+						lefts[i] = tree[i].returnLeftNodeID();
+						rights[i] = tree[i].returnRightNodeID();
+						depths[i] = tree[i].returnDepth();
+					}
+					forestFile.writeArray(cutValues);
+					forestFile.writeArray(lefts);
+					forestFile.writeArray(rights);
+					forestFile.writeArray(depths);
+					forestFile.writeArray(featureCounts);
+					forestFile.writeArray(features);
+				}
+
+
+				//a node's children are after it, so traversal always ends.
+				inline bool isValidChild(int child, unsigned int node){
+					return child > (int)node && child < (int)tree.size();
+				}
+
+
+				inline bool isValidClass(int classNum){
+					return 0 <= classNum && classNum < context->returnNumClasses();
+				}
+
+
+				inline bool isValidFeatures(const int* features, int numFeatures){
+					for(int i = 0; i < numFeatures; ++i){
+						if(features[i] < 0 || features[i] >= context->returnNumFeatures()){
+							return false;
+						}
+					}
+					return true;
+				}
+
+
+				inline void loadTree(forestFileReader& forestFile){
+					std::vector<T> cutValues;
+					std::vector<int> lefts;
+					std::vector<int> rights;
+					std::vector<int> depths;
+					std::vector<int> featureCounts;
+					std::vector<int> features;
+					forestFile.readArray(cutValues);
+					forestFile.readArray(lefts);
+					forestFile.readArray(rights);
+					forestFile.readArray(depths);
+					forestFile.readArray(featureCounts);
+					forestFile.readArray(features);
+					if(std::any_of(featureCounts.begin(), featureCounts.end(), [](int count){return count < 0;})){
+						throw std::runtime_error("saved tree has a negative feature count.");
+					}
+					if(std::accumulate(featureCounts.begin(), featureCounts.end(), (size_t)0) != features.size()){
+						throw std::runtime_error("saved tree has the wrong number of features.");
+					}
+					if(lefts.size() != cutValues.size() || rights.size() != cutValues.size() || depths.size() != cutValues.size() || featureCounts.size() != cutValues.size()){
+						throw std::runtime_error("saved tree fields differ in length.");
+					}
+					if(cutValues.empty()){
+						throw std::runtime_error("saved tree has no nodes.");
+					}
+
+					tree.clear();
+					tree.resize(cutValues.size());
+					const int* nextFeature = features.data();
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						if(lefts[i] == 0){
+							if(!isValidClass(rights[i])){
+								throw std::runtime_error("saved tree has a class out of range.");
+							}
+						}else if(!isValidChild(lefts[i], i) || !isValidChild(rights[i], i)){
+							throw std::runtime_error("saved tree has a child out of range.");
+						}else if(!isValidFeatures(nextFeature, featureCounts[i])){
+							throw std::runtime_error("saved tree has a feature out of range.");
+						}
+						tree[i].setCutValue(cutValues[i]);
+						tree[i].setLeftValue(lefts[i]);
+						tree[i].setRightValue(rights[i]);
+						tree[i].setDepth(depths[i]);
+						tree[i].setFeatureValue(std::vector<int>(nextFeature, nextFeature+featureCounts[i]));
+						nextFeature += featureCounts[i];
+					}
+				}
+
+
 				std::vector<int> growTreeTest(){
 					//JLP testing.
 					std::vector<int> outSampleIndices;
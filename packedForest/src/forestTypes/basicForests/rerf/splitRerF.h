@@ -53,7 +53,7 @@ namespace fp{
 				}
 
 			public:
-				splitRerF(const std::vector<int>& labelVector): labels(labelVector){
+				splitRerF(const std::vector<int>& labelVector, const int numClasses): leftClasses(numClasses), rightClasses(numClasses), labels(labelVector){
 					rightClasses.findNumClasses(labels);
 					leftClasses.setClassVecSize(rightClasses.returnClassVecSize());
 					setCombinedVecSize();
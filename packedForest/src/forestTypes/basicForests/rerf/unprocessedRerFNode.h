@@ -19,15 +19,15 @@ namespace fp{
 				//std::random_device rd;
 				//The next three should be static
 				//std::mt19937 rng(rd());   
-				//std::uniform_int_distribution<int> randomMtry(0,fpSingleton::getSingleton().returnMtry()-1);
-				//std::uniform_int_distribution<int> randomFeature(0,fpSingleton::getSingleton().returnNumFeatures()-1);
+				//std::uniform_int_distribution<int> randomMtry(0,this->context->returnMtry()-1);
+				//std::uniform_int_distribution<int> randomFeature(0,this->context->returnNumFeatures()-1);
 				//Example: auto random_integer = uni(rng);
 
 			public:
-				unprocessedRerFNode(int numObsForRoot): baseUnprocessedNode<T>::baseUnprocessedNode(numObsForRoot), featuresToTry(fpSingleton::getSingleton().returnMtry()){}
+				unprocessedRerFNode(fpContext& forestContext, int numObsForRoot): baseUnprocessedNode<T>::baseUnprocessedNode(forestContext, numObsForRoot), featuresToTry(forestContext.returnMtry()){}
 
 
-				unprocessedRerFNode(int parentID, int dep, bool isLeft): baseUnprocessedNode<T>::baseUnprocessedNode(parentID, dep, isLeft), featuresToTry(fpSingleton::getSingleton().returnMtry()){}
+				unprocessedRerFNode(fpContext& forestContext, int parentID, int dep, bool isLeft): baseUnprocessedNode<T>::baseUnprocessedNode(forestContext, parentID, dep, isLeft), featuresToTry(forestContext.returnMtry()){}
 
 
 				~unprocessedRerFNode(){}
@@ -56,18 +56,29 @@ namespace fp{
 				inline void pickMTRY(){
 					int rndMtry;
 					int rndFeature;
-					int mtryDensity = (int)((double)fpSingleton::getSingleton().returnMtry()*fpSingleton::getSingleton().returnMtryMult());
+					int mtryDensity = (int)((double)this->context->returnMtry()*this->context->returnMtryMult());
 					for (int i=0; i < mtryDensity; ++i){
-						rndMtry = std::rand() % fpSingleton::getSingleton().returnMtry();
-						rndFeature = std::rand() % fpSingleton::getSingleton().returnNumFeatures();
+						rndMtry = std::rand() % this->context->returnMtry();
+						rndFeature = std::rand() % this->context->returnNumFeatures();
 						featuresToTry[rndMtry].push_back(rndFeature);
 					}
 				}
 
+				inline void loadFeatureHolder(){
+					if(this->context->dataIsRowMajor()){
+						loadFeatureHolder(this->context->template returnRowMajorAccessor<T>());
+					}else{
+						loadFeatureHolder(this->context->template returnColMajorAccessor<T>());
+					}
+				}
+
 				//Note, this seems like a really intimidating function but it is just a 
 				//basic prefetched gather operation.  Without prefetching this function
-				//would be less than half as long.
-				inline void loadFeatureHolder(){
+				//would be less than half as long.  X is read through an accessor
+				//(see dataAccessors.h) so the gathers inline rather than calling
+				//through fpData.
+				template <typename A>
+				inline void loadFeatureHolder(const A& data){
 				int numToPrefetch=globalPrefetchSize;
 					if(baseUnprocessedNode<T>::obsIndices->useBin()){
 						if(baseUnprocessedNode<T>::obsIndices->returnBinnedSize() < globalPrefetchSize){
@@ -75,16 +86,16 @@ namespace fp{
 						}
 						//load the first feature
 						for(int q=0; q<numToPrefetch; q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+							data.prefetchFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; ++i){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
-							baseUnprocessedNode<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
+							data.prefetchFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
+							baseUnprocessedNode<T>::featureHolder[i] = data.returnFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
 						}
 
 						for(int q=baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnBinnedSize(); ++q){
-							baseUnprocessedNode<T>::featureHolder[q] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+							baseUnprocessedNode<T>::featureHolder[q] = data.returnFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 						//load all additional features
@@ -93,16 +104,16 @@ namespace fp{
 							for(unsigned int j =1; j < featuresToTry.back().size(); ++j){
 
 								for(int q=0; q<numToPrefetch; q++){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+									data.prefetchFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 								}
 
 								for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; ++i){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
-									baseUnprocessedNode<T>::featureHolder[i] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
+									data.prefetchFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
+									baseUnprocessedNode<T>::featureHolder[i] += data.returnFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
 								}
 
 								for(int q=baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnBinnedSize(); ++q){
-									baseUnprocessedNode<T>::featureHolder[q] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+									baseUnprocessedNode<T>::featureHolder[q] += data.returnFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 								}
 
 							}
@@ -113,16 +124,16 @@ namespace fp{
 						}
 						//load the first feature
 						for(int q=0; q<numToPrefetch; q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+							data.prefetchFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; ++i){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
-							baseUnprocessedNode<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(i));
+							data.prefetchFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
+							baseUnprocessedNode<T>::featureHolder[i] = data.returnFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(i));
 						}
 
 						for(int q=baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnInSampleSize(); ++q){
-							baseUnprocessedNode<T>::featureHolder[q] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+							baseUnprocessedNode<T>::featureHolder[q] = data.returnFeatureValue(featuresToTry.back()[0],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 						}
 
 
@@ -131,16 +142,16 @@ namespace fp{
 							for(int j =1; j < (int)featuresToTry.back().size(); ++j){
 
 								for(int q=0; q<numToPrefetch; q++){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+									data.prefetchFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 								}
 
 								for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; ++i){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
-									baseUnprocessedNode<T>::featureHolder[i] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(i));
+									data.prefetchFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
+									baseUnprocessedNode<T>::featureHolder[i] += data.returnFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(i));
 								}
 
 								for(int q=baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnInSampleSize(); ++q){
-									baseUnprocessedNode<T>::featureHolder[q] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+									baseUnprocessedNode<T>::featureHolder[q] += data.returnFeatureValue(featuresToTry.back()[j],baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 								}
 
 							}
@@ -160,7 +171,7 @@ namespace fp{
 					T featureVal = 0;
 
 					for(auto j : bestSplitInfo.returnFeatureNum()){
-						featureVal += fpSingleton::getSingleton().returnFeatureVal(j,index);
+						featureVal += this->context->template returnFeatureVal<T>(j,index);
 					}
 
 					if(featureVal <= bestSplitInfo.returnSplitValue()){
@@ -177,8 +188,8 @@ namespace fp{
 
 				inline void moveDataLeftOrRight(){
 
-					baseUnprocessedNode<T>::leftIndices = new stratifiedInNodeClassIndices();
-					baseUnprocessedNode<T>::rightIndices = new stratifiedInNodeClassIndices();
+					baseUnprocessedNode<T>::leftIndices = new stratifiedInNodeClassIndices(*this->context);
+					baseUnprocessedNode<T>::rightIndices = new stratifiedInNodeClassIndices(*this->context);
 
 					int lNum =0;
 					int rNum =0;
@@ -210,7 +221,7 @@ namespace fp{
 
 				inline void findBestSplit(){
 					//timeLogger logTime;
-					splitRerF<T> findSplit(baseUnprocessedNode<T>::labelHolder); //This is done twice
+					splitRerF<T> findSplit(baseUnprocessedNode<T>::labelHolder, this->context->returnNumClasses()); //This is done twice
 					//TODO This needs to change to real mtry
 					//	std::vector<int> tempVec;
 					//	tempVec.push_back(0);
@@ -17,6 +17,7 @@ namespace fp {
 		class fpForestClassificationBase : public fpForestBase<T>
 	{
 		protected:
+			fpContext* context;
 			std::vector<rfTree<T> > trees;
 			int numCorrect = 0;
 			int numOOB = 0;
@@ -26,6 +27,7 @@ namespace fp {
 			fpDisplayProgress printProgress;
 
 			//			using fpForestBase<T>::fpForestBase;
+			fpForestClassificationBase(fpContext& forestContext) : context(&forestContext){}
 			~fpForestClassificationBase(){}
 
 			inline void printForestType(){
@@ -33,12 +35,12 @@ namespace fp {
 			}
 
 			inline void changeForestSize(){
-				trees.resize(fpSingleton::getSingleton().returnNumTrees());
+				trees.resize(context->returnNumTrees(), rfTree<T>(*context));
 			}
 
 			inline void growTrees(){
 
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
+#pragma omp parallel for num_threads(context->returnNumThreads())
 				for(unsigned int i = 0; i < trees.size(); ++i){
 					printProgress.displayProgress(i);
 					trees[i].growTree();
@@ -58,7 +60,7 @@ namespace fp {
 				int totalLeafDepth=0;
 
 				int tempMaxDepth;
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					tempMaxDepth = trees[i].returnMaxDepth();
 					maxDepth = ((maxDepth < tempMaxDepth) ? tempMaxDepth : maxDepth);
 
@@ -80,7 +82,7 @@ namespace fp {
 				std::cout << "max depth: " << treeStats["maxDepth"] << "\n";
 				std::cout << "avg depth: " << float(treeStats["totalLeafDepth"])/float(treeStats["totalLeafNodes"]) << "\n";
 				std::cout << "num leaf nodes: " << treeStats["totalLeafNodes"] << "\n";
-				std::cout << "avg num leaf nodes per tree: " << treeStats["totalLeafNodes"]/fpSingleton::getSingleton().returnNumTrees() << "\n";
+				std::cout << "avg num leaf nodes per tree: " << treeStats["totalLeafNodes"]/context->returnNumTrees() << "\n";
 				std::cout << "OOB Accuracy: " << treeStats["OOBaccuracy"] << "\n";
 			}
 
@@ -96,13 +98,13 @@ namespace fp {
 			}
 
 			inline int predictClass(int observationNumber){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observationNumber)];
 				}
 
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -116,13 +118,13 @@ inline std::map<std::pair<int, int>, double> returnPairMat(){
 
 inline int predictClass(const T* observation){
 	/*
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -134,13 +136,13 @@ inline int predictClass(const T* observation){
 
 
 			inline int predictClass(std::vector<T>& observation){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(classTally[bestClass] < classTally[j]){
 						bestClass = j;
 					}
@@ -149,9 +151,35 @@ inline int predictClass(const T* observation){
 			}
 
 
+			inline void predictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions){
+				this->predictBatchByRow(X, numObservations, numFeatures, rowMajor, predictions, context->returnNumThreads());
+			}
+
+
+			inline void saveForest(forestFileWriter& forestFile){
+				forestFile.writeValue((int32_t)trees.size());
+				for(auto& tree : trees){
+					tree.saveTree(forestFile);
+				}
+			}
+
+
+			inline void loadForest(forestFileReader& forestFile){
+				const int numTrees = forestFile.readValue<int32_t>();
+				if(numTrees != context->returnNumTrees()){
+					throw std::runtime_error("saved forest has the wrong number of trees.");
+				}
+				trees.clear();
+				trees.resize(numTrees, rfTree<T>(*context));
+				for(auto& tree : trees){
+					tree.loadTree(forestFile);
+				}
+			}
+
+
 			inline std::vector<int> predictClassPost(std::vector<T>& observation){
-				std::vector<int> classTally(fpSingleton::getSingleton().returnNumClasses(),0);
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				std::vector<int> classTally(context->returnNumClasses(),0);
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					++classTally[trees[i].predictObservation(observation)];
 				}
 				return classTally;
@@ -162,11 +190,11 @@ inline int predictClass(const T* observation){
 				int numTried = 0;
 				int numWrong = 0;
 
-				for (int i = 0; i <fpSingleton::getSingleton().returnNumObservations();i++){
+				for (int i = 0; i <context->returnNumObservations();i++){
 					++numTried;
 					int predClass = predictClass(i);
 
-					if(predClass != fpSingleton::getSingleton().returnTestLabel(i)){
+					if(predClass != context->returnTestLabel(i)){
 						++numWrong;
 					}
 				}
@@ -183,7 +211,7 @@ inline int predictClass(const T* observation){
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes. returnOOBvotes is an n x 2 vector with
@@ -215,7 +243,7 @@ inline int predictClass(const T* observation){
 					// Tally the number of correct predictions.
 					// i.first is the observation index.
 					// i.second is the predicted class.
-					if(fpSingleton::getSingleton().returnLabel(i.first) == i.second){
+					if(context->returnLabel(i.first) == i.second){
 						numCorrect++;
 					}
 				}
@@ -239,7 +267,7 @@ inline int predictClass(const T* observation){
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes.
@@ -262,8 +290,8 @@ inline int predictClass(const T* observation){
 
 				for(auto& i : oobIndices){
 					std::vector<T> tmp;
-					for(int j = 0; j < fpSingleton::getSingleton().returnNumFeatures(); j++){
-						tmp.push_back(fpSingleton::getSingleton().returnFeatureVal(j, i));
+					for(int j = 0; j < context->returnNumFeatures(); j++){
+						tmp.push_back(context->returnFeatureVal<T>(j, i));
 					}
 					dataValues.push_back(tmp);
 				}
@@ -276,7 +304,7 @@ inline int predictClass(const T* observation){
 				std::map<int, int> oobBestClass;
 				// A vector of vectors (numObs X numClasses) for storing
 				// the class tallies.
-			    std::vector<std::vector<int>> oobClassVotes(fpSingleton::getSingleton().returnNumObservations(), std::vector<int>(fpSingleton::getSingleton().returnNumClasses(), 0));
+			    std::vector<std::vector<int>> oobClassVotes(context->returnNumObservations(), std::vector<int>(context->returnNumClasses(), 0));
 
 				// Iterate over trees to get oob points and add up their
 				// class votes.
@@ -54,7 +54,7 @@ namespace fp{
 				}
 
 			public:
-				fpSplit(const std::vector<int>& labelVector): labels(labelVector){
+				fpSplit(const std::vector<int>& labelVector, const int numClasses): leftClasses(numClasses), rightClasses(numClasses), labels(labelVector){
 					rightClasses.findNumClasses(labels);
 					leftClasses.setClassVecSize(rightClasses.returnClassVecSize());
 					setCombinedVecSize();
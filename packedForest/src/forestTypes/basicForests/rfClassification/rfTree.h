@@ -1,6 +1,7 @@
 #ifndef rfTree_h
 #define rfTree_h
 #include "../../../baseFunctions/fpBaseNode.h"
+#include "../../../baseFunctions/forestFile.h"
 #include <vector>
 #include <random>
 #include "unprocessedNode.h"
@@ -11,26 +12,27 @@ namespace fp{
 		class rfTree
 		{
 			protected:
+				fpContext* context;
 				float totalOOB;
 				std::vector<std::vector<int> > indexAndVote;
 				std::vector< fpBaseNode<T, int> > tree;
 				std::vector< unprocessedNode<T> > nodeQueue;
 
 			public:
-				rfTree() : totalOOB(0){}
+				rfTree(fpContext& forestContext) : context(&forestContext), totalOOB(0){}
 
 				void loadFirstNode(){
-					nodeQueue.emplace_back(fpSingleton::getSingleton().returnNumObservations());
+					nodeQueue.emplace_back(*context, context->returnNumObservations());
 				}
 
 				inline bool shouldProcessNode(){
 					if(nodeQueue.back().returnNodeImpurity()==0){
 						return false;
 					}
-					if(nodeQueue.back().returnInSampleSize() <= fpSingleton::getSingleton().returnMinParent()){
+					if(nodeQueue.back().returnInSampleSize() <= context->returnMinParent()){
 						return false;
 					}
-					if (nodeQueue.back().returnDepth()>= fpSingleton::getSingleton().returnMaxDepth()){
+					if (nodeQueue.back().returnDepth()>= context->returnMaxDepth()){
 						return false;
 					}
 					return true;
@@ -155,10 +157,10 @@ namespace fp{
 
 					nodeQueue.pop_back();
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isLeftNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isLeftNode());
 					nodeQueue.back().loadIndices(leftIndices);
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isRightNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isRightNode());
 					nodeQueue.back().loadIndices(rightIndices);
 				}
 
@@ -212,7 +214,7 @@ namespace fp{
 					T featureVal;
 					while(tree[currNode].isInternalNode()){
 						featureNum = tree[currNode].returnFeatureNumber();
-						featureVal = fpSingleton::getSingleton().returnTestFeatureVal(featureNum,observationNum);
+						featureVal = context->returnTestFeatureVal<T>(featureNum,observationNum);
 						currNode = tree[currNode].fpBaseNode<T, int>::nextNode(featureVal);
 					}
 					return tree[currNode].returnClass();
@@ -228,6 +230,85 @@ namespace fp{
 				}
 
 
+				//a tree is saved as one array per node field.
+				inline void saveTree(forestFileWriter& forestFile){
+					std::vector<T> cutValues(tree.size());
+					std::vector<int> lefts(tree.size());
+					std::vector<int> rights(tree.size());
+					std::vector<int> depths(tree.size());
+					std::vector<int> features(tree.size());
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						features[i] = tree[i].returnFeatureNumber();
+					}
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						cutValues[i] = tree[i].returnCutValue();
+						lefts[i] = tree[i].returnLeftNodeID();
+						rights[i] = tree[i].returnRightNodeID();
+						depths[i] = tree[i].returnDepth();
+					}
+					forestFile.writeArray(cutValues);
+					forestFile.writeArray(lefts);
+					forestFile.writeArray(rights);
+					forestFile.writeArray(depths);
+					forestFile.writeArray(features);
+				}
+
+
+				//a node's children are after it, so traversal always ends.
+				inline bool isValidChild(int child, unsigned int node){
+					return child > (int)node && child < (int)tree.size();
+				}
+
+
+				inline bool isValidClass(int classNum){
+					return 0 <= classNum && classNum < context->returnNumClasses();
+				}
+
+
+				inline bool isValidFeature(int feature){
+					return 0 <= feature && feature < context->returnNumFeatures();
+				}
+
+
+				inline void loadTree(forestFileReader& forestFile){
+					std::vector<T> cutValues;
+					std::vector<int> lefts;
+					std::vector<int> rights;
+					std::vector<int> depths;
+					std::vector<int> features;
+					forestFile.readArray(cutValues);
+					forestFile.readArray(lefts);
+					forestFile.readArray(rights);
+					forestFile.readArray(depths);
+					forestFile.readArray(features);
+					if(lefts.size() != cutValues.size() || rights.size() != cutValues.size() || depths.size() != cutValues.size() || features.size() != cutValues.size()){
+						throw std::runtime_error("saved tree fields differ in length.");
+					}
+					if(cutValues.empty()){
+						throw std::runtime_error("saved tree has no nodes.");
+					}
+
+					tree.clear();
+					tree.resize(cutValues.size());
+					for(unsigned int i = 0; i < tree.size(); ++i){
+						if(lefts[i] == 0){
+							if(!isValidClass(rights[i])){
+								throw std::runtime_error("saved tree has a class out of range.");
+							}
+						}else if(!isValidChild(lefts[i], i) || !isValidChild(rights[i], i)){
+							throw std::runtime_error("saved tree has a child out of range.");
+						}else if(!isValidFeature(features[i])){
+							throw std::runtime_error("saved tree has a feature out of range.");
+						}
+						tree[i].setCutValue(cutValues[i]);
+						tree[i].setLeftValue(lefts[i]);
+						tree[i].setRightValue(rights[i]);
+						tree[i].setDepth(depths[i]);
+						tree[i].setFeatureValue(features[i]);
+					}
+				}
+
+
 				std::vector<int> growTreeTest(){
 					//JLP testing.
 					std::vector<int> outSampleIndices;
@@ -15,11 +15,11 @@ namespace fp{
 				splitInfo<T> bestSplitInfo;
 				std::vector<int> featuresToTry;
 			public:
-				unprocessedNode(int numObsForRoot): baseUnprocessedNode<T>::baseUnprocessedNode(numObsForRoot){}
+				unprocessedNode(fpContext& forestContext, int numObsForRoot): baseUnprocessedNode<T>::baseUnprocessedNode(forestContext, numObsForRoot){}
 
 
-				unprocessedNode(int parentID, int dep, bool isLeft): baseUnprocessedNode<T>::baseUnprocessedNode(parentID, dep, isLeft){
-					featuresToTry.reserve(fpSingleton::getSingleton().returnNumFeatures());
+				unprocessedNode(fpContext& forestContext, int parentID, int dep, bool isLeft): baseUnprocessedNode<T>::baseUnprocessedNode(forestContext, parentID, dep, isLeft){
+					featuresToTry.reserve(this->context->returnNumFeatures());
 				}
 
 				~unprocessedNode(){}
@@ -43,7 +43,7 @@ namespace fp{
 				}
 
 				inline void pickMTRY(){
-					for (int i=0; i<fpSingleton::getSingleton().returnNumFeatures(); ++i){
+					for (int i=0; i<this->context->returnNumFeatures(); ++i){
 						featuresToTry.push_back(i);
 					}
 
@@ -52,14 +52,14 @@ namespace fp{
 
 					int tempSwap;
 
-					for(int locationToMove = 0; locationToMove < fpSingleton::getSingleton().returnMtry(); locationToMove++){
-						std::uniform_int_distribution<> distr(locationToMove, fpSingleton::getSingleton().returnNumFeatures()-1);
+					for(int locationToMove = 0; locationToMove < this->context->returnMtry(); locationToMove++){
+						std::uniform_int_distribution<> distr(locationToMove, this->context->returnNumFeatures()-1);
 						int randomPosition = distr(eng);
 						tempSwap = featuresToTry[locationToMove];
 						featuresToTry[locationToMove] = featuresToTry[randomPosition];
 						featuresToTry[randomPosition] = tempSwap;
 					}
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					featuresToTry.resize(this->context->returnMtry());
 				}
 
 
@@ -71,17 +71,17 @@ namespace fp{
 						}
 
 						for(int q=0; q<numToPrefetch; ++q){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 
 						for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; ++i){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
-							baseUnprocessedNode<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i+numToPrefetch));
+							baseUnprocessedNode<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(i));
 						}
 
 						for(int q=baseUnprocessedNode<T>::obsIndices->returnBinnedSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnBinnedSize(); ++q){
-							baseUnprocessedNode<T>::featureHolder[q] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
+							baseUnprocessedNode<T>::featureHolder[q] = this->context->template returnFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 					}else{
@@ -90,16 +90,16 @@ namespace fp{
 						}
 
 						for(int q=0; q<numToPrefetch; ++q){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; ++i){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
-							baseUnprocessedNode<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(i));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(i+numToPrefetch));
+							baseUnprocessedNode<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(i));
 						}
 
 						for(int q=baseUnprocessedNode<T>::obsIndices->returnInSampleSize()-numToPrefetch; q<baseUnprocessedNode<T>::obsIndices->returnInSampleSize(); ++q){
-							baseUnprocessedNode<T>::featureHolder[q] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(q));
+							baseUnprocessedNode<T>::featureHolder[q] = this->context->template returnFeatureVal<T>(featuresToTry.back(),baseUnprocessedNode<T>::obsIndices->returnInSample(q));
 						}
 
 					}
@@ -114,7 +114,7 @@ namespace fp{
 
 
 				inline bool goLeft(const int index){
-					T featureVal = fpSingleton::getSingleton().returnFeatureVal(bestSplitInfo.returnFeatureNum(),index);
+					T featureVal = this->context->template returnFeatureVal<T>(bestSplitInfo.returnFeatureNum(),index);
 
 					if(featureVal <= bestSplitInfo.returnSplitValue()){
 						return true;
@@ -126,8 +126,8 @@ namespace fp{
 
 				inline void moveDataLeftOrRight(){
 
-					baseUnprocessedNode<T>::leftIndices = new stratifiedInNodeClassIndices();
-					baseUnprocessedNode<T>::rightIndices = new stratifiedInNodeClassIndices();
+					baseUnprocessedNode<T>::leftIndices = new stratifiedInNodeClassIndices(*this->context);
+					baseUnprocessedNode<T>::rightIndices = new stratifiedInNodeClassIndices(*this->context);
 
 					int lNum =0;
 					int rNum =0;
@@ -168,7 +168,7 @@ namespace fp{
 
 				inline void findBestSplit(){
 					//timeLogger logTime;
-					fpSplit<T> findSplit(baseUnprocessedNode<T>::labelHolder); //This is done twice
+					fpSplit<T> findSplit(baseUnprocessedNode<T>::labelHolder, this->context->returnNumClasses()); //This is done twice
 					while(!featuresToTry.empty()){
 						//logTime.startGiniTimer();
 						loadFeatureHolder();
@@ -5,12 +5,14 @@
 #include <random>
 #include <vector>
 #include <algorithm>
+#include "../../fpSingleton/fpContext.h"
 
 namespace fp{
 
 	class stratifiedInNodeClassIndices
 	{
 		private:
+			fpContext* context;
 			std::vector<std::vector<int> > inSamples;
 			std::vector<int> inSamps;
 			std::vector<std::vector<int> > outSamples;
@@ -20,10 +22,10 @@ namespace fp{
 
 			//TODO: the following functions would benefit from Vitter's Sequential Random Sampling
 		public:
-			stratifiedInNodeClassIndices(): inSamples(fpSingleton::getSingleton().returnNumClasses()), outSamples(fpSingleton::getSingleton().returnNumClasses()), inSampleSize(0), outSampleSize(0){}
+			stratifiedInNodeClassIndices(fpContext& forestContext): context(&forestContext), inSamples(context->returnNumClasses()), outSamples(context->returnNumClasses()), inSampleSize(0), outSampleSize(0){}
 
 
-			stratifiedInNodeClassIndices(const int &numObservationsInDataSet): inSamples(fpSingleton::getSingleton().returnNumClasses()), outSamples(fpSingleton::getSingleton().returnNumClasses()), inSampleSize(0), outSampleSize(0){
+			stratifiedInNodeClassIndices(fpContext& forestContext, const int &numObservationsInDataSet): context(&forestContext), inSamples(context->returnNumClasses()), outSamples(context->returnNumClasses()), inSampleSize(0), outSampleSize(0){
 
 				createInAndOutSets(numObservationsInDataSet);
 
@@ -57,7 +59,7 @@ namespace fp{
 				int tempMoveObs;
 				for(int n=0; n<numObs; n++){
 					randomObsID = distr(eng);
-					inSamples[fpSingleton::getSingleton().returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[randomObsID]);
+					inSamples[context->returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[randomObsID]);
 					inSamps.push_back(potentialSamples[randomObsID]);
 					// swap if we haven't sampled this value before.
 					if(randomObsID < numUnusedObs){
@@ -69,7 +71,7 @@ namespace fp{
 				}
 
 				for(int n=0; n<numUnusedObs; ++n){
-					outSamples[fpSingleton::getSingleton().returnLabel(potentialSamples[n])].push_back(potentialSamples[n]);
+					outSamples[context->returnLabel(potentialSamples[n])].push_back(potentialSamples[n]);
 				}
 			}
 
@@ -169,15 +171,15 @@ namespace fp{
 
 
 			inline int returnBinSize(){
-				return fpSingleton::getSingleton().returnBinSize();
+				return context->returnBinSize();
 			}
 
 inline int returnBinMin(){
-				return fpSingleton::getSingleton().returnBinMin();
+				return context->returnBinMin();
 			}
 
 			inline bool useBin(){
-				return fpSingleton::getSingleton().returnUseBinning() && (inSampleSize > returnBinMin());
+				return context->returnUseBinning() && (inSampleSize > returnBinMin());
 			}
 
 			inline void initializeBinnedSamples(){
@@ -208,13 +210,13 @@ inline int returnBinMin(){
 
 			inline void addIndexToOutSamples(int index){
 				++outSampleSize;
-				outSamples[fpSingleton::getSingleton().returnLabel(index)].push_back(index);
+				outSamples[context->returnLabel(index)].push_back(index);
 			}
 
 			inline void addIndexToInSamples(int index){
 				++inSampleSize;
 				
-				inSamples[fpSingleton::getSingleton().returnLabel(index)].push_back(index);
+				inSamples[context->returnLabel(index)].push_back(index);
 				inSamps.push_back(index);
 			}
 	};//class stratifiedInNodeClassIndices
@@ -36,7 +36,7 @@ namespace fp{
 					return impurity;
 				}
 
-				inline void setFeature(F fNum){
+				inline void setFeature(const F& fNum){
 					featureNum = fNum;
 				}
 
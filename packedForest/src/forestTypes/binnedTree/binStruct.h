@@ -2,23 +2,59 @@
 #define binStruct_h
 #include "../../baseFunctions/fpBaseNode.h"
 #include "../../baseFunctions/MWC.h"
+#include "../../baseFunctions/accumulatorType.h"
 #include "obsIndexAndClassVec.h"
 #include "zipClassAndValue.h"
 #include "processingNodeBin.h"
+#include "oobVoteTally.h"
 #include <vector>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <type_traits>
+#include <mutex>
 #include <assert.h>
 
 namespace fp{
 
+	//the lock of a bin.  Copying a bin gives the copy a lock of its own.
+	class binLock
+	{
+		protected:
+			std::mutex nodesLock;
+
+		public:
+			binLock(){}
+			binLock(const binLock&){}
+			binLock& operator=(const binLock&){
+				return *this;
+			}
+
+			inline void lock(){
+				nodesLock.lock();
+			}
+
+			inline void unlock(){
+				nodesLock.unlock();
+			}
+	};
+
+
 	template <typename T, typename Q>
 		class binStruct
 		{
 			protected:
+				//values are stored as T but summed and compared as V.
+				typedef typename accumulatorType<T>::type V;
+
+				fpContext* context;
 				float OOBAccuracy;
 				float correctOOB;
 				float totalOOB;
-				std::vector< fpBaseNode<T,Q> > bin;
+				std::vector< fpBaseNode<V,Q> > bin;
 				std::vector<processingNodeBin<T,Q> > nodeQueue;
+				//grown nodes kept for reuse so their buffers are not reallocated.
+				std::vector<processingNodeBin<T,Q> > nodePool;
 
 				int numberOfNodes;
 
@@ -26,9 +62,27 @@ namespace fp{
 				int currTree;
 
 				obsIndexAndClassVec indicesHolder;
-				std::vector<zipClassAndValue<int, T> > zipper;
+				std::vector<zipClassAndValue<int, V> > zipper;
+
+				std::vector<int> bootstrapWeights;
+
+				//values of the best projection tried by the node being grown.
+				std::vector<V> projectionCache;
+
+				//the forest's summed area tables, NULL unless patches use them.
+				const T* summedAreaTables;
+
+				//a bit per observation per tree, set if the tree did not sample
+				//it, and the forest's out of bag votes the bin adds to.
+				std::vector<uint64_t> oobMasks;
+				int oobMaskWords;
+				oobVoteTally* forestOOBVotes;
+
+				//iterators of the node being split, copied before it is recycled.
+				nodeIterators childIterators;
 
-				std::vector<int> nodeIndices;
+				//held by node tasks while they change bin.
+				binLock binNodesLock;
 
 
 				randomNumberRerFMWC randNum;
@@ -44,48 +98,127 @@ namespace fp{
 					return true;
 				}
 
+				//a node waiting to be grown when nodes are grown as tasks.
+				struct nodeTask{
+					nodeIterators nodeIts;
+					zipperIterators<int,V> zipIts;
+					bool isLeft;
+					int parentPosition;
+					int depth;
+					int seed;
+				};
+
 			public:
-				binStruct() : OOBAccuracy(-1.0),correctOOB(0),totalOOB(0),numberOfNodes(0),numOfTreesInBin(0),currTree(0), indicesHolder(fpSingleton::getSingleton().returnNumClasses()){	}
+				binStruct(fpContext& forestContext) : context(&forestContext), OOBAccuracy(-1.0),correctOOB(0),totalOOB(0),numberOfNodes(0),numOfTreesInBin(0),currTree(0), indicesHolder(context->returnNumClasses()), summedAreaTables(NULL), oobMaskWords(0), forestOOBVotes(NULL), childIterators(context->returnNumClasses()){	}
+
+
+				inline void setSummedAreaTables(const std::vector<T>& tables){
+					summedAreaTables = tables.empty() ? NULL : tables.data();
+				}
+
+
+				inline void setOOBVoteTally(oobVoteTally& votes){
+					forestOOBVotes = &votes;
+				}
+
+
+				inline void pushNode(int tr, int pN, int d){
+					if(nodePool.empty()){
+						nodeQueue.emplace_back(tr, pN, d, randNum, *context);
+						nodeQueue.back().setProjectionCache(projectionCache);
+						nodeQueue.back().setSummedAreaTables(summedAreaTables);
+					}else{
+						nodeQueue.push_back(std::move(nodePool.back()));
+						nodePool.pop_back();
+						nodeQueue.back().resetNode(tr, pN, d, randNum);
+					}
+				}
+
+
+				inline void popNode(){
+					nodePool.push_back(std::move(nodeQueue.back()));
+					nodeQueue.pop_back();
+				}
 
 
 				inline void loadFirstNode(){
-					//inline void loadFirstNode(obsIndexAndClassVec& indicesHolder, std::vector<zipClassAndValue<int, T> >& zipper){
-					nodeQueue.emplace_back(0,0,0,randNum);
+					//inline void loadFirstNode(obsIndexAndClassVec& indicesHolder, std::vector<zipClassAndValue<int, V> >& zipper){
+					pushNode(0,0,0);
 					nodeQueue.back().setupRoot(indicesHolder, zipper);
 					nodeQueue.back().processNode();
 					if(nodeQueue.back().isLeafNode()){
 						makeRootALeaf();
+						popNode();
 					}else{
 						copyProcessedRootToBin();
 						createRootChildNodes();
 					}
 				}
 
+				//a root that is a leaf is marked like the shared leaf nodes so
+				//traversal stops on it.
 				inline void makeRootALeaf(){
-					bin[returnRootLocation()].setClass(nodeQueue.back().returnNodeClass());
-					bin[returnRootLocation()].setDepth(0);
+					bin[returnRootLocation()].setSharedClass(nodeQueue.back().returnNodeClass());
 				}
 
+				/*
+				 * The sample of a tree is stored once per observation with its
+				 * multiplicity as a weight rather than as repeated indices, so
+				 * a bootstrap loads, sorts and partitions about 37% fewer
+				 * entries.  With sampleFraction below 1 the tree is grown on a
+				 * subsample without replacement, every weight 1.
+				 */
 				inline void setSharedVectors(obsIndexAndClassVec& indicesInNode){
 					indicesInNode.resetVectors();
+					if(context->returnSampleFraction() < 1.0){
+						setSubsample(indicesInNode);
+					}else{
+						setBootstrap(indicesInNode);
+					}
+					if(context->returnComputeOOB()){
+						recordOOB(indicesInNode);
+					}
+				}
 
-					int numUnusedObs = fpSingleton::getSingleton().returnNumObservations();
-					int randomObsID;
-					int tempMoveObs;
 
-					for(int n = 0; n < fpSingleton::getSingleton().returnNumObservations(); n++){
-						randomObsID = randNum.gen(fpSingleton::getSingleton().returnNumObservations());
+				inline void recordOOB(obsIndexAndClassVec& indicesInNode){
+					uint64_t* mask = &oobMasks[(size_t)currTree*oobMaskWords];
+					const uint16_t* obsWeights = indicesInNode.returnObsWeights();
+					for(int obs = 0; obs < context->returnNumObservations(); ++obs){
+						if(!obsWeights[obs]){
+							mask[obs/64] |= uint64_t(1) << (obs%64);
+						}
+					}
+				}
 
-						indicesInNode.insertIndex(nodeIndices[randomObsID], fpSingleton::getSingleton().returnLabel(nodeIndices[randomObsID]));
 
-						if(randomObsID < numUnusedObs){
-							--numUnusedObs;
-							tempMoveObs = nodeIndices[numUnusedObs];
-							nodeIndices[numUnusedObs] = nodeIndices[randomObsID];
-							nodeIndices[randomObsID] = tempMoveObs;
+				inline void setBootstrap(obsIndexAndClassVec& indicesInNode){
+					bootstrapWeights.assign(context->returnNumObservations(), 0);
+					for(int n = 0; n < context->returnNumObservations(); n++){
+						++bootstrapWeights[randNum.gen(context->returnNumObservations())];
+					}
+
+					for(int obs = 0; obs < context->returnNumObservations(); ++obs){
+						if(bootstrapWeights[obs]){
+							indicesInNode.insertIndex(obs, context->returnLabel(obs), bootstrapWeights[obs]);
 						}
 					}
+				}
+
+
+				//sequential selection sampling: each observation is taken with
+				//probability (still needed)/(still to be seen), one pass and
+				//exactly numToSample observations.
+				inline void setSubsample(obsIndexAndClassVec& indicesInNode){
+					const int numObs = context->returnNumObservations();
+					int numToSample = std::max(1, (int)(context->returnSampleFraction()*numObs));
 
+					for(int obs = 0; obs < numObs && numToSample; ++obs){
+						if(randNum.gen(numObs-obs) < numToSample){
+							indicesInNode.insertIndex(obs, context->returnLabel(obs));
+							--numToSample;
+						}
+					}
 				}
 
 
@@ -105,7 +238,7 @@ namespace fp{
 
 
 				inline void makeLeafNodes(){
-					for(int i= 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
+					for(int i= 0; i < context->returnNumClasses(); ++i){
 						bin[i].setSharedClass(i);
 					}
 				}
@@ -129,7 +262,7 @@ namespace fp{
 				}
 
 				inline int returnRootLocation(){
-					return currTree+fpSingleton::getSingleton().returnNumClasses();
+					return currTree+context->returnNumClasses();
 				}
 
 
@@ -143,11 +276,11 @@ namespace fp{
 
 
 				inline void linkParentToLeaf(){
-					assert(nodeQueue.back().returnParentNodeNumber() >= fpSingleton::getSingleton().returnNumClasses());
+					assert(nodeQueue.back().returnParentNodeNumber() >= context->returnNumClasses());
 					assert(nodeQueue.back().returnParentNodeNumber() <= parentNodesPosition());
 
 					assert(nodeQueue.back().returnNodeClass() >= 0);
-					assert(nodeQueue.back().returnNodeClass() < fpSingleton::getSingleton().returnNumClasses());
+					assert(nodeQueue.back().returnNodeClass() < context->returnNumClasses());
 
 					if(nodeQueue.back().returnIsLeftNode()){
 						bin[nodeQueue.back().returnParentNodeNumber()].setLeftValue(nodeQueue.back().returnNodeClass());
@@ -158,51 +291,51 @@ namespace fp{
 
 
 				inline void createChildNodes(){
-					nodeIterators nodeIts(nodeQueue.back().returnNodeIterators());
-					zipperIterators<int,T> zipIts(nodeQueue.back().returnZipIterators());
+					childIterators = nodeQueue.back().returnNodeIterators();
+					zipperIterators<int,V> zipIts(nodeQueue.back().returnZipIterators());
 					int childDepth = returnDepthOfNode()+1;
 					if(nodeQueue.back().isLeftChildLarger()){
-						nodeQueue.pop_back();
-						//TODO: don't emplace_back if should be leaf node.
-						nodeQueue.emplace_back(1,parentNodesPosition(), childDepth, randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, rightNode());
-						nodeQueue.emplace_back(1,parentNodesPosition(), childDepth, randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, leftNode());
+						popNode();
+						//TODO: don't push if should be leaf node.
+						pushNode(1,parentNodesPosition(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, rightNode());
+						pushNode(1,parentNodesPosition(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, leftNode());
 					}else{
-						nodeQueue.pop_back();
-						nodeQueue.emplace_back(1,parentNodesPosition(), childDepth, randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, leftNode());
-						nodeQueue.emplace_back(1,parentNodesPosition(), childDepth, randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, rightNode());
+						popNode();
+						pushNode(1,parentNodesPosition(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, leftNode());
+						pushNode(1,parentNodesPosition(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, rightNode());
 					}
 				}
 
 
 				inline void createRootChildNodes(){
-					nodeIterators nodeIts(nodeQueue.back().returnNodeIterators());
-					zipperIterators<int,T> zipIts(nodeQueue.back().returnZipIterators());
+					childIterators = nodeQueue.back().returnNodeIterators();
+					zipperIterators<int,V> zipIts(nodeQueue.back().returnZipIterators());
 					int childDepth = returnDepthOfNode()+1;
 					if(nodeQueue.back().isLeftChildLarger()){
-						nodeQueue.pop_back();
-						//TODO: don't emplace_back if should be leaf node.
-						nodeQueue.emplace_back(1,returnRootLocation(), childDepth,randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, rightNode());
-						nodeQueue.emplace_back(1,returnRootLocation(), childDepth, randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, leftNode());
+						popNode();
+						//TODO: don't push if should be leaf node.
+						pushNode(1,returnRootLocation(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, rightNode());
+						pushNode(1,returnRootLocation(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, leftNode());
 					}else{
-						nodeQueue.pop_back();
-						nodeQueue.emplace_back(1,returnRootLocation(), childDepth,randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, leftNode());
-						nodeQueue.emplace_back(1,returnRootLocation(), childDepth,randNum);
-						nodeQueue.back().setupNode(nodeIts, zipIts, rightNode());
+						popNode();
+						pushNode(1,returnRootLocation(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, leftNode());
+						pushNode(1,returnRootLocation(), childDepth);
+						nodeQueue.back().setupNode(childIterators, zipIts, rightNode());
 					}
 				}
 
 				inline void processLeafNode(){
 					assert(nodeQueue.back().returnNodeSize() > 0);
-					assert(nodeQueue.back().returnNodeSize() <= fpSingleton::getSingleton().returnNumObservations());
+					assert(nodeQueue.back().returnNodeSize() <= context->returnNumObservations());
 					linkParentToLeaf();
-					nodeQueue.pop_back();
+					popNode();
 				}
 
 
@@ -232,313 +365,290 @@ namespace fp{
 				}
 
 
-				inline void createBin(int numTrees, int randSeed){
-					numOfTreesInBin = numTrees;
-					randNum.initialize(randSeed);
-					initializeStructures();
-					for(; currTree < numOfTreesInBin; ++currTree){
-						setSharedVectors(indicesHolder);
-						loadFirstNode();	
-						while(!nodeQueue.empty()){
-							processNode();
-						}
-					}
-					removeStructures();
-				}
-
-				inline void initializeStructures(){
-					zipper.resize(fpSingleton::getSingleton().returnNumObservations());
-					nodeIndices.resize(fpSingleton::getSingleton().returnNumObservations());
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumObservations(); ++i){
-						nodeIndices[i] =i;
+				/*
+				 * Node tasks.  With useNodeTasks a tree is grown as OpenMP tasks
+				 * rather than through nodeQueue: the children of a node with at
+				 * least globalNodeTaskMin observations become tasks any idle
+				 * thread can pick up, smaller subtrees are grown by the task that
+				 * reaches them.  Each node draws from its own generator seeded by
+				 * its parent's, so a tree is the same whichever threads grew it.
+				 * Nodes only touch their own range of indicesHolder and zipper;
+				 * bin is shared by the whole bin and is only changed while holding
+				 * the bin's own lock, so trees of other bins and forests never
+				 * wait on it.
+				 */
+				inline void linkParent(int parentPosition, bool isLeft, int childValue){
+					if(isLeft){
+						bin[parentPosition].setLeftValue(childValue);
+					}else{
+						bin[parentPosition].setRightValue(childValue);
 					}
-					bin.resize(numOfTreesInBin+fpSingleton::getSingleton().returnNumClasses());
-					makeLeafNodes();
 				}
 
 
-				inline void removeStructures(){
-					std::vector<processingNodeBin<T,Q> >().swap( nodeQueue );
-					//indicesHolder.removeObsIndexAndClassVec();
-					std::vector<zipClassAndValue<int, T> >().swap( zipper );
-					std::vector<int>().swap( nodeIndices);
-				}
-
+				inline void queueChildTasks(processingNodeBin<T,Q>& node, randomNumberRerFMWC& nodeRandNum, int position, int childDepth, std::vector<nodeTask>& localTasks){
+					nodeTask leftChild = {node.returnNodeIterators(), node.returnZipIterators(), leftNode(), position, childDepth, nodeRandNum.gen(std::numeric_limits<int>::max())};
+					nodeTask rightChild = {node.returnNodeIterators(), node.returnZipIterators(), rightNode(), position, childDepth, nodeRandNum.gen(std::numeric_limits<int>::max())};
 
-				inline int returnMaxDepth(){
-					int maxDepth=0;
-					for(auto& node : bin){
-						// +1 accounts for the leaf nodes which are never created (optimization that cuts memory required for a forest in half)
-						if(maxDepth < node.returnDepth()+1){
-							maxDepth = node.returnDepth()+1;
-						}
+					if(node.returnNodeSize() >= globalNodeTaskMin){
+#pragma omp task firstprivate(leftChild)
+						growNodeTask(leftChild);
+#pragma omp task firstprivate(rightChild)
+						growNodeTask(rightChild);
+					}else{
+						localTasks.push_back(rightChild);
+						localTasks.push_back(leftChild);
 					}
-					return maxDepth;
 				}
 
 
-				inline int returnNumLeafNodes(){
-					return (int)bin.size() - fpSingleton::getSingleton().returnNumClasses() + numOfTreesInBin;
-				}
+				inline void growNodeTask(const nodeTask& task){
+					std::vector<nodeTask> localTasks(1, task);
+					randomNumberRerFMWC nodeRandNum;
+					processingNodeBin<T,Q> node(1, task.parentPosition, task.depth, nodeRandNum, *context);
+					node.setProjectionCache(projectionCache);
+					node.setSummedAreaTables(summedAreaTables);
+					while(!localTasks.empty()){
+						nodeTask current = localTasks.back();
+						localTasks.pop_back();
 
+						nodeRandNum.initialize(current.seed);
+						node.resetNode(1, current.parentPosition, current.depth, nodeRandNum);
+						node.setupNode(current.nodeIts, current.zipIts, current.isLeft);
+						node.processNode();
 
-				inline int returnLeafDepthSum(){
-					int leafDepthSums=0;
-					for(auto& node : bin){
-						if(node.isInternalNodeFront()){
-							if(node.returnLeftNodeID() < fpSingleton::getSingleton().returnNumClasses()){
-								leafDepthSums += node.returnDepth()+1;
-							}
-							if(node.returnRightNodeID() < fpSingleton::getSingleton().returnNumClasses()){
-								leafDepthSums += node.returnDepth()+1;
+						if(node.isLeafNode()){
+							{
+								std::lock_guard<binLock> lock(binNodesLock);
+								linkParent(current.parentPosition, current.isLeft, node.returnNodeClass());
 							}
+							continue;
 						}
-					}
-					return leafDepthSums;
-				}
 
-				/////////////////////////
-				// This is required to template the predictObservation function
-				// //////////////////////////////
-				template<typename U>
-					struct identity { typedef U type; };
-
-				inline void predictBinObservation(int observationNum, std::vector<int>& preds){
-					predictBinObservation(observationNum,preds, identity<Q>());
-				}
-
-				inline void predictBinObservation(std::vector<T>& observation, std::vector<int>& preds){
-					predictBinObservation(observation,preds,identity<Q>());
+						int position;
+						{
+							std::lock_guard<binLock> lock(binNodesLock);
+							bin.emplace_back(node.returnNodeCutValue(), current.depth, node.returnNodeCutFeature());
+							position = positionOfNextNode();
+							linkParent(current.parentPosition, current.isLeft, position);
+						}
+						queueChildTasks(node, nodeRandNum, position, current.depth+1, localTasks);
+					}
 				}
 
-				////////////////////////////////
 
-				//PredictForRF
-				inline void predictBinObservation(int observationNum,std::vector<int>& preds, identity<int> ){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					int featureNum;
-					T featureVal;
-					int q;
+				inline void growTreeAsTasks(){
+					randomNumberRerFMWC rootRandNum;
+					rootRandNum.initialize(randNum.gen(std::numeric_limits<int>::max()));
+					processingNodeBin<T,Q> root(0,0,0, rootRandNum, *context);
+					root.setProjectionCache(projectionCache);
+					root.setSummedAreaTables(summedAreaTables);
+					root.setupRoot(indicesHolder, zipper);
+					root.processNode();
 
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
+					if(root.isLeafNode()){
+						bin[returnRootLocation()].setSharedClass(root.returnNodeClass());
+						return;
 					}
-
-					do{
-						numberNotInLeaf = 0;
-
-						for( q=0; q<numOfTreesInBin; ++q){
-
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureNum = bin[currNode[q]].returnFeatureNumber();
-								featureVal = fpSingleton::getSingleton().returnTestFeatureVal(featureNum,observationNum);
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(featureVal);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
-							}
+					bin[returnRootLocation()].setDepth(0);
+					bin[returnRootLocation()].setCutValue(root.returnNodeCutValue());
+					bin[returnRootLocation()].setFeatureValue(root.returnNodeCutFeature());
+
+					//the next tree reuses indicesHolder and zipper so every task
+					//of this tree has to finish first.
+					std::vector<nodeTask> localTasks;
+#pragma omp taskgroup
+					{
+						queueChildTasks(root, rootRandNum, returnRootLocation(), 1, localTasks);
+						while(!localTasks.empty()){
+							nodeTask current = localTasks.back();
+							localTasks.pop_back();
+							growNodeTask(current);
 						}
-
-					}while(numberNotInLeaf);
-
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
 					}
 				}
 
 
-
-				inline void predictBinObservation(int observationNum, std::vector<int>& preds, identity<std::vector<int> >){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					T featureVal;
-					int  q;
-
-
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
-					}
-
-					do{
-						numberNotInLeaf = 0;
-
-						for( q=0; q<numOfTreesInBin; ++q){
-
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureVal = 0;
-								for(auto i : bin[currNode[q]].returnFeatureNumber()){
-									featureVal += fpSingleton::getSingleton().returnTestFeatureVal(i,observationNum);
-								}
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(featureVal);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
+				inline void createBin(int numTrees, int randSeed){
+					numOfTreesInBin = numTrees;
+					randNum.initialize(randSeed);
+					initializeStructures();
+					for(; currTree < numOfTreesInBin; ++currTree){
+						setSharedVectors(indicesHolder);
+						if(context->returnUseNodeTasks()){
+							growTreeAsTasks();
+						}else{
+							loadFirstNode();	
+							while(!nodeQueue.empty()){
+								processNode();
 							}
 						}
-
-					}while(numberNotInLeaf);
-
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
 					}
+					if(context->returnComputeOOB()){
+						tallyOOBVotes();
+					}
+					removeStructures();
 				}
 
 
-				inline void predictBinObservation(int observationNum, std::vector<int>& preds, identity<weightedFeature>){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					T featureVal;
-					int weightNum;
-					int  q;
-
-
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
+				template <typename A>
+					inline V projectObservation(const A& data, int feature, int obs){
+						return data.returnFeatureValue(feature, obs);
 					}
 
-					do{
-						numberNotInLeaf = 0;
-
-						for( q=0; q<numOfTreesInBin; ++q){
-
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureVal = 0;
-								weightNum = 0;
-								for(auto i : bin[currNode[q]].returnFeatureNumber().returnFeatures()){
-									featureVal += fpSingleton::getSingleton().returnTestFeatureVal(i,observationNum)*bin[currNode[q]].returnFeatureNumber().returnWeights()[weightNum++];
-								}
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(featureVal);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
-							}
+				template <typename A>
+					inline V projectObservation(const A& data, std::vector<int>& features, int obs){
+						V featureVal = 0;
+						for(auto i : features){
+							featureVal += data.returnFeatureValue(i, obs);
 						}
+						return featureVal;
+					}
 
-					}while(numberNotInLeaf);
-
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
+				template <typename A>
+					inline V projectObservation(const A& data, weightedFeature& features, int obs){
+						V featureVal = 0;
+						for(int i = 0; i < (int)features.returnFeatures().size(); ++i){
+							featureVal += data.returnFeatureValue(features.returnFeatures()[i], obs)*(V)features.returnWeights()[i];
+						}
+						return featureVal;
 					}
-				}
 
-				inline void predictBinObservation(std::vector<T>& observation, std::vector<int>& preds,identity<int> ){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					int featureNum;
-					int q;
 
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
+				inline void tallyOOBVotes(){
+					if(summedAreaTables != NULL){
+						tallyOOBVotes(rowMajorAccessor<T>(summedAreaTables, summedAreaTable::returnTableSize(context->returnImageHeight(), context->returnImageWidth())));
+					}else if(context->dataIsRowMajor()){
+						tallyOOBVotes(context->returnRowMajorAccessor<T>());
+					}else{
+						tallyOOBVotes(context->returnColMajorAccessor<T>());
 					}
+				}
 
-					do{
-						numberNotInLeaf = 0;
 
-						for( q=0; q<numOfTreesInBin; ++q){
+				//an observation walks every tree that did not sample it a level
+				//at a time, as in packedBin::predictObservation, so the loads of the
+				//different trees overlap.  Votes are counted a block of
+				//observations at a time and added to the forest's votes.
+				template <typename A>
+					inline void tallyOOBVotes(const A& data){
+						const int numClasses = context->returnNumClasses();
+						const int numObservations = context->returnNumObservations();
+						std::vector<int> currNode(numOfTreesInBin);
+						std::vector<int> blockVotes;
 
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureNum = bin[currNode[q]].returnFeatureNumber();
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(observation[featureNum]);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
+						for(int blockStart = 0; blockStart < numObservations; blockStart += globalOOBTallyBlockSize){
+							const int blockEnd = std::min(blockStart+globalOOBTallyBlockSize, numObservations);
+							blockVotes.assign((size_t)(blockEnd-blockStart)*numClasses, 0);
+							for(int obs = blockStart; obs < blockEnd; ++obs){
+								tallyOOBObservation(data, obs, currNode, &blockVotes[(size_t)(obs-blockStart)*numClasses]);
 							}
+							forestOOBVotes->addVotes(blockStart, numClasses, blockVotes);
 						}
-
-					}while(numberNotInLeaf);
-
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
+						std::vector<uint64_t>().swap( oobMasks );
 					}
-				}
 
 
-				inline void predictBinObservation(std::vector<T>& observation, std::vector<int>& preds, identity<std::vector<int> >){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					T featureVal;
-					int  q;
+				template <typename A>
+					inline void tallyOOBObservation(const A& data, const int obs, std::vector<int>& currNode, int* obsVotes){
+						const int numClasses = context->returnNumClasses();
+						int numOOBTrees;
+						int numberNotInLeaf;
+						int q;
 
+						const uint64_t obsBit = uint64_t(1) << (obs%64);
+						numOOBTrees = 0;
+						for(int tree = 0; tree < numOfTreesInBin; ++tree){
+							if(oobMasks[(size_t)tree*oobMaskWords + obs/64] & obsBit){
+								currNode[numOOBTrees++] = tree+numClasses;
+							}
+						}
 
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
-					}
-
-					do{
-						numberNotInLeaf = 0;
-
-						for( q=0; q<numOfTreesInBin; ++q){
-
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureVal = 0;
-								for(auto i : bin[currNode[q]].returnFeatureNumber()){
-									featureVal +=observation[i];
+						do{
+							numberNotInLeaf = 0;
+							for(q = 0; q < numOOBTrees; ++q){
+								if(bin[currNode[q]].isInternalNodeFront()){
+									currNode[q] = bin[currNode[q]].fpBaseNode<V, Q>::nextNode(projectObservation(data, bin[currNode[q]].returnFeatureNumber(), obs));
+									__builtin_prefetch(&bin[currNode[q]], 0, 3);
+									++numberNotInLeaf;
 								}
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(featureVal);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
 							}
+						}while(numberNotInLeaf);
+
+						for(q = 0; q < numOOBTrees; ++q){
+							++obsVotes[bin[currNode[q]].returnClass()];
 						}
+					}
 
-					}while(numberNotInLeaf);
 
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
+				inline void initializeStructures(){
+					zipper.resize(context->returnNumObservations());
+					bin.resize(numOfTreesInBin+context->returnNumClasses());
+					makeLeafNodes();
+					if(context->returnComputeOOB()){
+						oobMaskWords = (context->returnNumObservations()+63)/64;
+						oobMasks.assign((size_t)numOfTreesInBin*oobMaskWords, 0);
+					}
+					if(!std::is_same<Q,int>::value && 2*sizeof(V)*(size_t)context->returnNumObservations() <= globalProjectionCacheMaxBytes){
+						projectionCache.resize(2*(size_t)context->returnNumObservations());
 					}
 				}
 
 
-				//Prediction function for ternary sparse matrix
-				inline void predictBinObservation(std::vector<T>& observation, std::vector<int>& preds, identity<weightedFeature>){
-					std::vector<int> currNode(numOfTreesInBin);
-					int numberNotInLeaf;
-					T featureVal;
-					int weightNum;
-					int  q;
+				inline void removeStructures(){
+					std::vector<processingNodeBin<T,Q> >().swap( nodeQueue );
+					std::vector<processingNodeBin<T,Q> >().swap( nodePool );
+					//indicesHolder.removeObsIndexAndClassVec();
+					std::vector<zipClassAndValue<int, V> >().swap( zipper );
+					std::vector<int>().swap( bootstrapWeights);
+					std::vector<V>().swap( projectionCache );
+					std::vector<uint64_t>().swap( oobMasks );
+				}
 
 
-					for( q=0; q<numOfTreesInBin; ++q){
-						currNode[q] = q+fpSingleton::getSingleton().returnNumClasses();
-						__builtin_prefetch(&bin[currNode[q]], 0, 3);
+				inline int returnMaxDepth(){
+					int maxDepth=0;
+					for(auto& node : bin){
+						// +1 accounts for the leaf nodes which are never created (optimization that cuts memory required for a forest in half)
+						if(maxDepth < node.returnDepth()+1){
+							maxDepth = node.returnDepth()+1;
+						}
 					}
+					return maxDepth;
+				}
 
-					do{
-						numberNotInLeaf = 0;
 
-						for( q=0; q<numOfTreesInBin; ++q){
+				inline int returnNumLeafNodes(){
+					return (int)bin.size() - context->returnNumClasses() + numOfTreesInBin;
+				}
 
-							if(bin[currNode[q]].isInternalNodeFront()){
-								featureVal = 0;
-								weightNum = 0;
-								for(auto i : bin[currNode[q]].returnFeatureNumber().returnFeatures()){
-									featureVal +=observation[i]*bin[currNode[q]].returnFeatureNumber().returnWeights()[weightNum++];
-								}
-								currNode[q] = bin[currNode[q]].fpBaseNode<T, Q>::nextNode(featureVal);
-								__builtin_prefetch(&bin[currNode[q]], 0, 3);
-								++numberNotInLeaf;
+
+				inline int returnLeafDepthSum(){
+					int leafDepthSums=0;
+					for(auto& node : bin){
+						if(node.isInternalNodeFront()){
+							if(node.returnLeftNodeID() < context->returnNumClasses()){
+								leafDepthSums += node.returnDepth()+1;
+							}
+							if(node.returnRightNodeID() < context->returnNumClasses()){
+								leafDepthSums += node.returnDepth()+1;
 							}
 						}
-
-					}while(numberNotInLeaf);
-
-					for( q=0; q<numOfTreesInBin; q++){
-#pragma omp atomic update
-						++preds[bin[currNode[q]].returnClass()];
 					}
+					return leafDepthSums;
 				}
+
+				//the grown nodes, read by packedBin.
+				inline std::vector< fpBaseNode<V,Q> >& returnNodes(){
+					return bin;
+				}
+
 				///////////////////////////////////
 				/// Test Functions not to be used in production
 				//////////////////////////////////
 
 
-				inline std::vector< fpBaseNode<T,Q> >& exposeBinTest(){
+				inline std::vector< fpBaseNode<V,Q> >& exposeBinTest(){
 					return bin;
 				}
 
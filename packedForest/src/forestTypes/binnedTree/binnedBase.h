@@ -7,7 +7,10 @@
 #include <ctime>
 #include <chrono>
 #include <cstdlib>
+#include <cstdint>
 #include "binStruct.h"
+#include "packedBin.h"
+#include "summedAreaTable.h"
 #include <random>
 #include <numeric>
 
@@ -22,36 +25,216 @@ namespace fp {
 		class binnedBase : public fpForestBase<T>
 	{
 		protected:
+			fpContext* context;
 			std::vector<binStruct<T, Q> > bins;
+			//the grown bins in the form predictions traverse.  bins is
+			//freed once these are packed.
+			std::vector<packedBin<T, Q> > packedBins;
+			std::map<std::string, int> forestStats;
 			int numBins;
 			std::map<std::pair<int, int>, double> pairMat;
 			std::vector<int> binSizes;
 			std::vector<int> binSeeds;
+			//one summed area table per training observation, kept while
+			//the bins grow and are packed.
+			std::vector<T> summedAreaTables;
+			//out of bag votes, kept while the bins grow.
+			oobVoteTally oobVotes;
+			float OOBAccuracy;
 
 
 			inline void checkParameters(){
-				if(fpSingleton::getSingleton().returnNumTreeBins() > fpSingleton::getSingleton().returnNumTrees()){
-					fpSingleton::getSingleton().setNumTreeBins(fpSingleton::getSingleton().returnNumTrees());
+				if(context->returnNumTreeBins() > context->returnNumTrees()){
+					context->setNumTreeBins(context->returnNumTrees());
 				}
 
-				if(fpSingleton::getSingleton().returnNumTreeBins() < 1){
-					fpSingleton::getSingleton().setNumTreeBins(fpSingleton::getSingleton().returnNumThreads());
+				if(context->returnNumTreeBins() < 1){
+					context->setNumTreeBins(context->returnNumThreads());
+				}
+
+				if(useSummedAreaTables() && !std::is_same<T, typename accumulatorType<T>::type>::value){
+					throw std::runtime_error("useSummedAreaTables needs data stored in a type that can hold the sum of an image.");
+				}
+			}
+
+
+			//structured RerF forests whose patches index summed area tables.
+			inline bool useSummedAreaTables(){
+				return std::is_same<Q,weightedFeature>::value && context->returnUseSummedAreaTables();
+			}
+
+
+			template<typename F>
+				inline std::vector<T> returnSummedAreaTable(const F& pixel){
+					std::vector<T> table(summedAreaTable::returnTableSize(context->returnImageHeight(), context->returnImageWidth()));
+					summedAreaTable::buildTable(pixel, context->returnImageHeight(), context->returnImageWidth(), table.data());
+					return table;
+				}
+
+
+			inline void buildSummedAreaTables(){
+				const int imageHeight = context->returnImageHeight();
+				const int imageWidth = context->returnImageWidth();
+				const size_t tableSize = summedAreaTable::returnTableSize(imageHeight, imageWidth);
+				summedAreaTables.resize(tableSize*context->returnNumObservations());
+#pragma omp parallel for num_threads(context->returnNumThreads())
+				for(int i = 0; i < context->returnNumObservations(); ++i){
+					summedAreaTable::buildTable([&](int pixel){return context->returnFeatureVal<T>(pixel, i);}, imageHeight, imageWidth, summedAreaTables.data()+tableSize*i);
+				}
+			}
+
+
+			//predictBin(k, votes) adds the votes of bin k to votes.  Each
+			//thread takes every numThreads-th bin and counts into its own
+			//tally, padded to whole cache lines, and the tallies are added
+			//into predictions once the bins are done.
+			template<typename F>
+				inline void predictBins(std::vector<int>& predictions, const F& predictBin){
+					const int numThreads = std::min(context->returnNumThreads(), numBins);
+					if(numThreads < 2){
+						for(int k = 0; k < numBins; ++k){
+							predictBin(k, predictions.data());
+						}
+						return;
+					}
+
+					const int numClasses = context->returnNumClasses();
+					const int intsPerCacheLine = globalCacheLineSize/sizeof(int);
+					const int stride = (numClasses+intsPerCacheLine-1)/intsPerCacheLine*intsPerCacheLine;
+					std::vector<int> tallyHolder((numThreads+1)*stride, 0);
+					int* tallies = tallyHolder.data();
+					tallies += (intsPerCacheLine - ((uintptr_t)tallies/sizeof(int))%intsPerCacheLine)%intsPerCacheLine;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static,1)
+					for(int thread = 0; thread < numThreads; ++thread){
+						for(int k = thread; k < numBins; k += numThreads){
+							predictBin(k, tallies+thread*stride);
+						}
+					}
+
+					for(int thread = 0; thread < numThreads; ++thread){
+						for(int j = 0; j < numClasses; ++j){
+							predictions[j] += tallies[thread*stride+j];
+						}
+					}
+				}
+
+
+			inline void predictBins(std::vector<T>& observation, std::vector<int>& predictions){
+				rowMajorAccessor<T> observationData(observation.data(), (int)observation.size());
+				predictBins(predictions, [&](int k, int* votes){packedBins[k].predictObservation(observationData, 0, votes);});
+			}
+
+
+			//trees of summed area table forests are traversed with the
+			//observation's table rather than its pixels.
+			inline void predictObservation(std::vector<T>& observation, std::vector<int>& predictions){
+				if(useSummedAreaTables()){
+					std::vector<T> table = returnSummedAreaTable([&](int pixel){return observation[pixel];});
+					predictBins(table, predictions);
+				}else{
+					predictBins(observation, predictions);
 				}
 			}
 
+			//reads the test set through the context for predictClass(int).
+			class testDataAccessor
+			{
+				protected:
+					fpContext* context;
+
+				public:
+					testDataAccessor(fpContext* forestContext) : context(forestContext){}
+
+					inline T returnFeatureValue(const int featureNum, const int observationNum) const{
+						return context->returnTestFeatureVal<T>(featureNum, observationNum);
+					}
+			};
+
+
+			inline int returnBestClass(const int* predictions){
+				int bestClass = 0;
+				for(int j = 1; j < context->returnNumClasses(); ++j){
+					if(predictions[bestClass] < predictions[j]){
+						bestClass = j;
+					}
+				}
+				return bestClass;
+			}
+
+
+			//observations per tile given the bytes an observation takes while
+			//its tile is predicted.  Small batches are split so every thread
+			//gets a tile.
+			inline int returnPredictTileSize(size_t bytesPerObservation, int numObservations){
+				size_t binBytes = 0;
+				for(auto& bin : packedBins){
+					binBytes = std::max(binBytes, bin.returnNumBytes());
+				}
+				const size_t cacheLeft = globalPredictCacheBytes - std::min(binBytes, globalPredictCacheBytes/2);
+				int tileSize = (int)std::min(cacheLeft/bytesPerObservation, (size_t)globalPredictTileMax);
+				tileSize = std::max(tileSize, globalPredictTileMin);
+				tileSize = std::min(tileSize, (numObservations+context->returnNumThreads()-1)/context->returnNumThreads());
+				return std::max(tileSize, 1);
+			}
+
+
+			//a thread takes a tile of observations and passes it through one
+			//bin after another, so each bin stays in cache while the whole
+			//tile traverses it.  The tile's votes are the thread's own, so
+			//votes need no atomics and threads share nothing but the bins.
+			template<typename A>
+				inline void predictBatch(const A& data, int numObservations, int* predictions){
+					const int numClasses = context->returnNumClasses();
+					const int imageHeight = context->returnImageHeight();
+					const int imageWidth = context->returnImageWidth();
+					const int tableSize = summedAreaTable::returnTableSize(imageHeight, imageWidth);
+					const size_t observationBytes = useSummedAreaTables() ? tableSize*sizeof(T) : context->returnNumFeatures()*sizeof(T);
+					const int tileSize = returnPredictTileSize(observationBytes+numClasses*sizeof(int), numObservations);
+					const int numTiles = (numObservations+tileSize-1)/tileSize;
+					const int groupSize = context->returnPredictGroupSize();
+#pragma omp parallel num_threads(context->returnNumThreads())
+					{
+						std::vector<int> votes((size_t)tileSize*numClasses);
+						std::vector<T> tables(useSummedAreaTables() ? (size_t)tileSize*tableSize : 0);
+						rowMajorAccessor<T> tableData(tables.data(), tableSize);
+#pragma omp for schedule(dynamic)
+						for(int tile = 0; tile < numTiles; ++tile){
+							const int tileStart = tile*tileSize;
+							const int tileObservations = std::min(tileSize, numObservations-tileStart);
+							std::fill(votes.begin(), votes.end(), 0);
+							if(useSummedAreaTables()){
+								for(int i = 0; i < tileObservations; ++i){
+									summedAreaTable::buildTable([&](int pixel){return data.returnFeatureValue(pixel, tileStart+i);}, imageHeight, imageWidth, tables.data()+(size_t)i*tableSize);
+								}
+								for(int k = 0; k < numBins; ++k){
+									packedBins[k].predictTile(tableData, 0, tileObservations, groupSize, votes.data());
+								}
+							}else{
+								for(int k = 0; k < numBins; ++k){
+									packedBins[k].predictTile(data, tileStart, tileObservations, groupSize, votes.data());
+								}
+							}
+							for(int i = 0; i < tileObservations; ++i){
+								predictions[tileStart+i] = returnBestClass(votes.data()+(size_t)i*numClasses);
+							}
+						}
+					}
+				}
+
 		public:
 
 			~binnedBase(){}
-			binnedBase(){
+			binnedBase(fpContext& forestContext) : context(&forestContext), OOBAccuracy(-1.0){
 				checkParameters();
-				numBins =  fpSingleton::getSingleton().returnNumTreeBins();
+				numBins =  context->returnNumTreeBins();
 				generateSeedsForBins();
 			}
 
 			inline void generateSeedsForBins(){
 				binSeeds.resize(numBins);
 				for(int i = 0; i < numBins; ++i){
-					binSeeds[i] = fpSingleton::getSingleton().genRandom(std::numeric_limits<int>::max());
+					binSeeds[i] = context->genRandom(std::numeric_limits<int>::max());
 				}
 			}
 
@@ -64,9 +247,9 @@ namespace fp {
 			}
 
 			inline void calcBinSizes(){
-				int minBinSize = fpSingleton::getSingleton().returnNumTrees()/numBins;
+				int minBinSize = context->returnNumTrees()/numBins;
 				binSizes.resize(numBins,minBinSize);
-				int remainingTreesToBin = fpSingleton::getSingleton().returnNumTrees()-minBinSize*numBins;
+				int remainingTreesToBin = context->returnNumTrees()-minBinSize*numBins;
 				while(remainingTreesToBin != 0){
 					++binSizes[--remainingTreesToBin];
 				}
@@ -78,18 +261,65 @@ namespace fp {
 				calcBinSizes();
 
 				fpDisplayProgress printProgress;
-				bins.resize(numBins);
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
-				for(int j = 0; j < numBins; ++j){
-					bins[j].createBin(binSizes[j], binSeeds[j]);
+				if(useSummedAreaTables()){
+					buildSummedAreaTables();
+				}
+				binStruct<T,Q> emptyBin(*context);
+				emptyBin.setSummedAreaTables(summedAreaTables);
+				if(context->returnComputeOOB()){
+					oobVotes.initialize(context->returnNumObservations(), context->returnNumClasses());
+					emptyBin.setOOBVoteTally(oobVotes);
+				}
+				bins.resize(numBins, emptyBin);
+				if(context->returnUseNodeTasks()){
+					//bins start as tasks and spawn node tasks of their own so
+					//threads are not left idle when there are few bins.
+#pragma omp parallel num_threads(context->returnNumThreads())
+#pragma omp single
+					for(int j = 0; j < numBins; ++j){
+#pragma omp task firstprivate(j)
+						bins[j].createBin(binSizes[j], binSeeds[j]);
+					}
+				}else{
+#pragma omp parallel for num_threads(context->returnNumThreads())
+					for(int j = 0; j < numBins; ++j){
+						bins[j].createBin(binSizes[j], binSeeds[j]);
+					}
 				}
 				std::cout << "\n"<< std::flush;
 			}
 
+			//each observation is predicted by the trees that did not sample
+			//it; ties go to the lower class as in predictClass.
+			inline void calcOOBAccuracy(){
+				const int numClasses = context->returnNumClasses();
+				const std::vector<int>& votes = oobVotes.returnVotes();
+
+				int numOOB = 0;
+				int numCorrect = 0;
+				for(int i = 0; i < context->returnNumObservations(); ++i){
+					std::vector<int>::const_iterator obsVotes = votes.begin() + (size_t)i*numClasses;
+					std::vector<int>::const_iterator bestClass = std::max_element(obsVotes, obsVotes+numClasses);
+					if(*bestClass){
+						++numOOB;
+						if(bestClass - obsVotes == context->returnLabel(i)){
+							++numCorrect;
+						}
+					}
+				}
+				OOBAccuracy = numOOB ? (float)numCorrect/(float)numOOB : -1.0;
+				oobVotes.removeVotes();
+			}
+
 			inline float reportOOB(){
-				return -1;
+				return OOBAccuracy;
 			}
+			//stats of the grown trees, from before the bins were packed.
 			inline std::map<std::string, int> calcBinStats(){
+				return forestStats;
+			}
+
+			inline std::map<std::string, int> computeBinStats(){
 				int maxDepth=0;
 				int totalLeafNodes=0;
 				int totalLeafDepth=0;
@@ -111,16 +341,19 @@ namespace fp {
 			}
 
 			inline void binStats(){
-				std::map<std::string, int> binStats = calcBinStats();
+				std::map<std::string, int>& binStats = forestStats;
 
 				std::cout << "max depth: " << binStats["maxDepth"] << "\n";
 				std::cout << "avg leaf node depth: " << float(binStats["totalLeafDepth"])/float(binStats["totalLeafNodes"]) << "\n";
-				std::cout << "avg num leaf nodes per tree: " << binStats["totalLeafNodes"]/fpSingleton::getSingleton().returnNumTrees() << "\n";
+				std::cout << "avg num leaf nodes per tree: " << binStats["totalLeafNodes"]/context->returnNumTrees() << "\n";
 				std::cout << "num leaf nodes: " << binStats["totalLeafNodes"] << "\n";
+				if(context->returnComputeOOB()){
+					std::cout << "OOB Accuracy: " << OOBAccuracy << "\n";
+				}
 			}
 
 			void printBin0(){
-				bins[0].printBin();
+				packedBins[0].printBin();
 			}
 
 			inline void growForest(){
@@ -128,22 +361,156 @@ namespace fp {
 				//TODO: change this so forest isn't grown dynamically.
 				//changeForestSize();
 				growBins();
+				if(context->returnComputeOOB()){
+					calcOOBAccuracy();
+				}
+				forestStats = computeBinStats();
 				binStats();
+				packBins();
+				std::vector<T>().swap(summedAreaTables);
 			}
 
 
-			inline int predictClass(int observationNumber){
-				std::vector<int> predictions(fpSingleton::getSingleton().returnNumClasses(),0);
+			inline void packBins(){
+				packedBins.reserve(numBins);
+				for(auto& bin : bins){
+					packedBins.emplace_back(bin, context->returnNumClasses());
+				}
+				std::vector<binStruct<T, Q> >().swap(bins);
+				if(context->returnDepthIntertwined() >= 0){
+					reorderBins();
+				}
+			}
+
+
+			//lays each packed bin out by the visits of the training set.
+			inline void reorderBins(){
+				const int numObservations = context->returnNumObservations();
+				const int depthIntertwined = context->returnDepthIntertwined();
+				if(useSummedAreaTables()){
+					rowMajorAccessor<T> tableData(summedAreaTables.data(), summedAreaTable::returnTableSize(context->returnImageHeight(), context->returnImageWidth()));
+#pragma omp parallel for num_threads(context->returnNumThreads())
+					for(int k = 0; k < numBins; ++k){
+						packedBins[k].reorderNodes(tableData, numObservations, depthIntertwined);
+					}
+				}else if(context->dataIsRowMajor()){
+					rowMajorAccessor<T> data = context->returnRowMajorAccessor<T>();
+#pragma omp parallel for num_threads(context->returnNumThreads())
+					for(int k = 0; k < numBins; ++k){
+						packedBins[k].reorderNodes(data, numObservations, depthIntertwined);
+					}
+				}else{
+					colMajorAccessor<T> data = context->returnColMajorAccessor<T>();
+#pragma omp parallel for num_threads(context->returnNumThreads())
+					for(int k = 0; k < numBins; ++k){
+						packedBins[k].reorderNodes(data, numObservations, depthIntertwined);
+					}
+				}
+			}
+
+
+			inline void saveForest(forestFileWriter& forestFile){
+				forestFile.writeValue((int32_t)numBins);
+				for(auto& bin : packedBins){
+					bin.saveBin(forestFile);
+				}
+			}
 
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
+
+			//the bins' arrays stay in the mapped file.
+			inline void loadForest(forestFileReader& forestFile){
+				numBins = forestFile.readValue<int32_t>();
+				if(numBins < 1 || numBins > context->returnNumTrees()){
+					throw std::runtime_error("saved forest has the wrong number of bins.");
+				}
+				const int numFeatureValues = useSummedAreaTables() ? summedAreaTable::returnTableSize(context->returnImageHeight(), context->returnImageWidth()) : context->returnNumFeatures();
+				packedBins.clear();
+				packedBins.reserve(numBins);
+				long numTrees = 0;
 				for(int k = 0; k < numBins; ++k){
-					bins[k].predictBinObservation(observationNumber, predictions);
+					packedBins.emplace_back(forestFile, context->returnNumClasses(), numFeatureValues);
+					numTrees += packedBins.back().returnNumTrees();
 				}
+				if(numTrees != context->returnNumTrees()){
+					throw std::runtime_error("saved forest has the wrong number of trees.");
+				}
+			}
 
-				assert(std::accumulate(predictions.begin(), predictions.end(),0) == fpSingleton::getSingleton().returnNumTrees());
+
+			//the generated predictions match predictBatch when the source is
+			//compiled without -ffast-math, which could reorder the sums of
+			//projections.
+			inline void writeSource(std::ostream& source, const std::string& functionName){
+				if(useSummedAreaTables()){
+					throw std::runtime_error("writeSource does not support summed area table forests.");
+				}
+				const int numClasses = context->returnNumClasses();
+				const int numFeatures = context->returnNumFeatures();
+
+				source << "//Generated by packedForest from a " << context->returnForestType() << " forest of " << context->returnNumTrees() << " trees.\n";
+				source << "//Compile without -ffast-math so projections round as they did in the forest.\n";
+				source << "#include <cstddef>\n#include <cstdint>\n\n";
+				source << "namespace {\n\n";
+				source << "typedef " << sourceTypeName<T>::name() << " T;\n";
+				source << "typedef " << sourceTypeName<typename accumulatorType<T>::type>::name() << " V;\n";
+				source << "const int numClasses = " << numClasses << ";\n";
+				source << "const int numFeatures = " << numFeatures << ";\n\n";
+
+				int numTreesWritten = 0;
+				for(auto& bin : packedBins){
+					for(int q = 0; q < bin.returnNumTrees(); ++q){
+						bin.writeTreeSource(source, q, "tree" + std::to_string(numTreesWritten++));
+					}
+				}
+
+				source << "struct rowMajorObservation{\n";
+				source << "\tconst T* X;\n\tsize_t obs;\n";
+				source << "\tinline T operator()(int feature) const{ return X[obs*numFeatures + feature]; }\n};\n\n";
+				source << "struct colMajorObservation{\n";
+				source << "\tconst T* X;\n\tsize_t obs;\n\tsize_t numObservations;\n";
+				source << "\tinline T operator()(int feature) const{ return X[feature*numObservations + obs]; }\n};\n\n";
+
+				source << "template <typename A>\n";
+				source << "inline int predictObservation(const A& x){\n";
+				source << "\tint votes[numClasses] = {0};\n";
+				for(int tree = 0; tree < numTreesWritten; ++tree){
+					source << "\t++votes[tree" << tree << "(x)];\n";
+				}
+				source << "\tint bestClass = 0;\n";
+				source << "\tfor(int j = 1; j < numClasses; ++j){\n";
+				source << "\t\tif(votes[bestClass] < votes[j]){\n\t\t\tbestClass = j;\n\t\t}\n\t}\n";
+				source << "\treturn bestClass;\n}\n\n";
+				source << "} //namespace\n\n";
+
+				source << "//predictions are -1 when numFeatures is not the forest's.\n";
+				source << "extern \"C\" void " << functionName << "(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions){\n";
+				source << "\tconst bool sameFeatures = numFeatures == ::numFeatures;\n";
+				source << "#pragma omp parallel for schedule(static)\n";
+				source << "\tfor(int i = 0; i < numObservations; ++i){\n";
+				source << "\t\tif(!sameFeatures){\n\t\t\tpredictions[i] = -1;\n";
+				source << "\t\t}else if(rowMajor){\n";
+				source << "\t\t\tpredictions[i] = predictObservation(rowMajorObservation{X, (size_t)i});\n";
+				source << "\t\t}else{\n";
+				source << "\t\t\tpredictions[i] = predictObservation(colMajorObservation{X, (size_t)i, (size_t)numObservations});\n";
+				source << "\t\t}\n\t}\n}\n";
+			}
+
+
+			inline int predictClass(int observationNumber){
+				std::vector<int> predictions(context->returnNumClasses(),0);
+
+				if(useSummedAreaTables()){
+					std::vector<T> table = returnSummedAreaTable([&](int pixel){return context->returnTestFeatureVal<T>(pixel, observationNumber);});
+					predictBins(table, predictions);
+				}else{
+					testDataAccessor testData(context);
+					predictBins(predictions, [&](int k, int* votes){packedBins[k].predictObservation(testData, observationNumber, votes);});
+				}
+
+				assert(std::accumulate(predictions.begin(), predictions.end(),0) == context->returnNumTrees());
 
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(predictions[bestClass] < predictions[j]){
 						bestClass = j;
 					}
@@ -153,14 +520,10 @@ namespace fp {
 
 
 			inline int predictClass(std::vector<T>& observation){
-				std::vector<int> predictions(fpSingleton::getSingleton().returnNumClasses(),0);
-
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
-				for(int k = 0; k < numBins; ++k){
-					bins[k].predictBinObservation(observation, predictions);
-				}
+				std::vector<int> predictions(context->returnNumClasses(),0);
+				predictObservation(observation, predictions);
 				int bestClass = 0;
-				for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+				for(int j = 1; j < context->returnNumClasses(); ++j){
 					if(predictions[bestClass] < predictions[j]){
 						bestClass = j;
 					}
@@ -170,27 +533,23 @@ namespace fp {
 
 
 			inline std::vector<int> predictClassPost(std::vector<T>& observation){
-				std::vector<int> predictions(fpSingleton::getSingleton().returnNumClasses(),0);
-
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
-				for(int k = 0; k < numBins; ++k){
-					bins[k].predictBinObservation(observation, predictions);
-				}
+				std::vector<int> predictions(context->returnNumClasses(),0);
+				predictObservation(observation, predictions);
 				return predictions;
 			}
 
 
 			inline int predictClass(const T* observation){
 				/*
-					 std::vector<int> predictions(fpSingleton::getSingleton().returnNumClasses(),0);
+					 std::vector<int> predictions(context->returnNumClasses(),0);
 
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
+#pragma omp parallel for num_threads(context->returnNumThreads())
 for(int k = 0; k < numBins; ++k){
 bins[k].predictBinObservation(observation, predictions);
 }
 
 int bestClass = 0;
-for(int j = 1; j < fpSingleton::getSingleton().returnNumClasses(); ++j){
+for(int j = 1; j < context->returnNumClasses(); ++j){
 if(predictions[bestClass] < predictions[j]){
 bestClass = j;
 }
@@ -200,6 +559,14 @@ return bestClass;
 			return 0;
 			}
 
+			inline void predictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions){
+				if(rowMajor){
+					predictBatch(rowMajorAccessor<T>(X, numFeatures), numObservations, predictions);
+				}else{
+					predictBatch(colMajorAccessor<T>(X, numObservations), numObservations, predictions);
+				}
+			}
+
 inline std::map<std::pair<int, int>, double> returnPairMat(){
                                         return pairMat;
                                 }
@@ -208,11 +575,11 @@ inline float testForest(){
 	int numTried = 0;
 	int numWrong = 0;
 
-	for (int i = 0; i <fpSingleton::getSingleton().returnNumObservations();i++){
+	for (int i = 0; i <context->returnNumObservations();i++){
 		++numTried;
 		int predClass = predictClass(i);
 
-		if(predClass != fpSingleton::getSingleton().returnTestLabel(i)){
+		if(predClass != context->returnTestLabel(i)){
 			++numWrong;
 		}
 	}
@@ -0,0 +1,41 @@
+#ifndef forestSource_h
+#define forestSource_h
+
+#include <string>
+#include <sstream>
+#include <limits>
+#include <cstdint>
+
+namespace fp {
+
+	/**
+	 * Helpers for writing a packed forest as C++ source, see
+	 * binnedBase::writeSource.
+	 */
+
+	template <typename T>
+		struct sourceTypeName;
+
+	template <>
+		struct sourceTypeName<double>{ static const char* name(){ return "double"; } };
+
+	template <>
+		struct sourceTypeName<float>{ static const char* name(){ return "float"; } };
+
+	template <>
+		struct sourceTypeName<int>{ static const char* name(){ return "int"; } };
+
+	template <>
+		struct sourceTypeName<uint8_t>{ static const char* name(){ return "uint8_t"; } };
+
+
+	//a float literal that reads back as exactly cutValue.
+	inline std::string returnFloatLiteral(const float cutValue){
+		std::ostringstream literal;
+		literal.precision(std::numeric_limits<float>::max_digits10);
+		literal << std::showpoint << cutValue << "f";
+		return literal.str();
+	}
+
+} //namespace fp
+#endif //forestSource_h
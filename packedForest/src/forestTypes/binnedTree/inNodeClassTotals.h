@@ -2,30 +2,37 @@
 #define inNodeClassTotals_h
 
 #include <vector>
+#include <cstdint>
 #include "nodeIterators.h"
 #include <assert.h>
 #include <iostream>
 
 namespace fp{
 
+	/*
+	 * The impurity sum_i c_i(1-c_i/n) equals n - sum_i c_i^2/n, so the sum of
+	 * squared class totals is kept up to date as items move and each
+	 * impurity costs one division however many classes there are.
+	 */
 	class inNodeClassTotals{
 		protected:
 			int totalNumObj;
+			int64_t sumClassTotalsSquared;
 			float impurity;
 			std::vector<int> classVec;
 
 		public:
 			//TODO: This constructor will never be used.  Delete here and in tests.
-			inNodeClassTotals(nodeIterators& observationIterators) : totalNumObj(0), impurity(-1){
+			inNodeClassTotals(nodeIterators& observationIterators) : totalNumObj(0), sumClassTotalsSquared(0), impurity(-1){
 				setClassCardinalities(observationIterators);
 				setTotalNumObj();
 			}
 
-			inNodeClassTotals(int numClasses) : totalNumObj(0), impurity(-1){
+			inNodeClassTotals(int numClasses) : totalNumObj(0), sumClassTotalsSquared(0), impurity(-1){
 				classVec.resize(numClasses);
 			}
 
-			inNodeClassTotals() : totalNumObj(0), impurity(-1){
+			inNodeClassTotals() : totalNumObj(0), sumClassTotalsSquared(0), impurity(-1){
 				//used for root nodes
 			}
 
@@ -36,9 +43,12 @@ namespace fp{
 			}
 
 			inline void setTotalNumObj(){
+				totalNumObj = 0;
+				sumClassTotalsSquared = 0;
 				for(auto i : classVec){
 					assert(i >= 0);
 					totalNumObj+=i;
+					sumClassTotalsSquared += (int64_t)i*i;
 				}
 			}
 
@@ -49,6 +59,11 @@ namespace fp{
 				setTotalNumObj();
 			}
 
+			inline void setupWeightedClassTotals(nodeIterators& observationIterators){
+				observationIterators.setVecOfClassWeights(classVec);
+				setTotalNumObj();
+			}
+
 			inline int returnNumItems(){
 				return totalNumObj;
 			}
@@ -58,26 +73,13 @@ namespace fp{
 			}
 
 			inline float calcAndReturnImpurity(){
-				if(false){ //use gini impurity
-					int sumClassTotalsSquared = 0;
-					for(auto i : classVec){
-						sumClassTotalsSquared+=i*i;
-					}
-					return 1.0-float(sumClassTotalsSquared)/float(totalNumObj*totalNumObj);
-				}else{ //use what is this?
-					impurity = 0.0;
-					float classPercent;
-					for(auto i : classVec){
-						classPercent = (float)i/(float)totalNumObj;
-
-						impurity += (float)i*(1.0-classPercent);
-					}
-					return impurity;
-				}
+				impurity = totalNumObj ? (float)(totalNumObj - (double)sumClassTotalsSquared/totalNumObj) : 0.0f;
+				return impurity;
 			}
 
 
 			inline void decrementClass(int classNum){
+				sumClassTotalsSquared -= 2*(int64_t)classVec[classNum] - 1;
 				--classVec[classNum];
 				--totalNumObj;
 				assert(totalNumObj >=0);
@@ -85,19 +87,36 @@ namespace fp{
 
 
 			inline void incrementClass(int classNum){
+				sumClassTotalsSquared += 2*(int64_t)classVec[classNum] + 1;
 				++classVec[classNum];
 				++totalNumObj;
 				assert(totalNumObj >=0);
 			}
 
+			inline void addToClass(int classNum, int num){
+				sumClassTotalsSquared += (2*(int64_t)classVec[classNum] + num)*num;
+				classVec[classNum]+=num;
+				totalNumObj+=num;
+			}
+
+
+			inline void removeFromClass(int classNum, int num){
+				sumClassTotalsSquared -= (2*(int64_t)classVec[classNum] - num)*num;
+				classVec[classNum]-=num;
+				totalNumObj-=num;
+				assert(totalNumObj >=0);
+			}
+
 			inline void resetClassTotals(){
 				std::fill(classVec.begin(), classVec.end(), 0);
 				totalNumObj=0;
+				sumClassTotalsSquared=0;
 			}
 
-			inline void copyInNodeClassTotals(inNodeClassTotals nodeData){
+			inline void copyInNodeClassTotals(const inNodeClassTotals& nodeData){
 				//maxClass = nodeData.maxClass;
 				totalNumObj = nodeData.totalNumObj;
+				sumClassTotalsSquared = nodeData.sumClassTotalsSquared;
 				//impurity = nodeData.impurity;
 				classVec = nodeData.classVec;
 			}
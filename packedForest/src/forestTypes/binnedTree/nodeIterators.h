@@ -7,78 +7,124 @@
 
 namespace fp{
 
+	/*
+	 * The observations of a node, as a begin, end, and (once the node is
+	 * split) split position in each class vector of indexHolder.  Positions
+	 * are kept as four byte offsets rather than iterators so every node
+	 * carries half the data and copying them to children is cheaper.
+	 */
 	class nodeIterators
 	{
 		protected:
-			std::vector<std::vector<int>::iterator > iteratorHolderBegin;
-			std::vector<std::vector<int>::iterator > iteratorHolderEnd;
-			std::vector<std::vector<int>::iterator > iteratorHolderSplit;
+			obsIndexAndClassVec* indexHolder;
+			std::vector<obsIndex> offsetsBegin;
+			std::vector<obsIndex> offsetsEnd;
+			std::vector<obsIndex> offsetsSplit;
+
+			inline obsIndexIterator classBegin(int iterClass){
+				return indexHolder->returnClassVector(iterClass).begin();
+			}
 
 		public:
-			nodeIterators(int numClasses){
-				iteratorHolderBegin.resize(numClasses);
-				iteratorHolderEnd.resize(numClasses);
+			nodeIterators(int numClasses) : indexHolder(NULL){
+				offsetsBegin.resize(numClasses);
+				offsetsEnd.resize(numClasses);
+			}
+
+			inline void insertBeginIterator(const obsIndexIterator& beginIter, int iterClass){
+				offsetsBegin[iterClass] = beginIter - classBegin(iterClass);
 			}
 
-			inline void insertBeginIterator(const std::vector<int>::iterator& beginIter, int iterClass){
-				iteratorHolderBegin[iterClass] = beginIter;
+			inline obsIndexIterator returnBeginIterator(int iterClass){
+				return classBegin(iterClass) + offsetsBegin[iterClass];
 			}
 
-			inline const std::vector<int>::iterator& returnBeginIterator(int iterClass){
-				return iteratorHolderBegin[iterClass];
+			inline obsIndexIterator returnSplitIterator(int iterClass){
+				return classBegin(iterClass) + offsetsSplit[iterClass];
 			}
 
-			inline const std::vector<int>::iterator& returnSplitIterator(int iterClass){
-				return iteratorHolderSplit[iterClass];
+			inline void insertEndIterator(const obsIndexIterator& endIter, int iterClass){
+				offsetsEnd[iterClass] = endIter - classBegin(iterClass);
 			}
 
-			inline void insertEndIterator(const std::vector<int>::iterator& endIter, int iterClass){
-				iteratorHolderEnd[iterClass] = endIter;
+			inline obsIndexIterator returnEndIterator(int iterClass){
+				return classBegin(iterClass) + offsetsEnd[iterClass];
 			}
 
-			inline const std::vector<int>::iterator& returnEndIterator(int iterClass){
-				return iteratorHolderEnd[iterClass];
+			inline int returnClassSize(int iterClass){
+				return offsetsEnd[iterClass] - offsetsBegin[iterClass];
 			}
 
-			inline void setInitialIterators(obsIndexAndClassVec& indexHolder){
-				for(int i = 0; i < (int)iteratorHolderBegin.size(); ++i){
-					iteratorHolderBegin[i] = indexHolder.returnClassVector(i).begin();
-					iteratorHolderEnd[i] = indexHolder.returnClassVector(i).end();
-					assert(iteratorHolderEnd[i]-iteratorHolderBegin[i]>=0);
+			inline void setInitialIterators(obsIndexAndClassVec& indexes){
+				indexHolder = &indexes;
+				for(int i = 0; i < (int)offsetsBegin.size(); ++i){
+					offsetsBegin[i] = 0;
+					offsetsEnd[i] = indexHolder->returnClassVector(i).size();
 				}
 			}
 
 
 			inline void setNodeIterators(nodeIterators& nodeIters, bool isLeftNode){
+				indexHolder = nodeIters.indexHolder;
 				if(isLeftNode){
-					iteratorHolderBegin = nodeIters.iteratorHolderBegin;
-					iteratorHolderEnd = nodeIters.iteratorHolderSplit;
+					offsetsBegin = nodeIters.offsetsBegin;
+					offsetsEnd = nodeIters.offsetsSplit;
 				}	else{
-					iteratorHolderBegin = nodeIters.iteratorHolderSplit;
-					iteratorHolderEnd = nodeIters.iteratorHolderEnd;
+					offsetsBegin = nodeIters.offsetsSplit;
+					offsetsEnd = nodeIters.offsetsEnd;
 				}
 			}
 
 			inline void setVecOfClassSizes(std::vector<int>& classSizes){
 				//TODO: duplicate work.  should not grow, shrink, and regrow this vector.
 				classSizes.clear();
-				for(int i = 0; i < (int)iteratorHolderEnd.size(); ++i){
-					classSizes.push_back(iteratorHolderEnd[i]-iteratorHolderBegin[i]);
-					assert(iteratorHolderEnd[i]-iteratorHolderBegin[i] >= 0);	
+				for(int i = 0; i < (int)offsetsEnd.size(); ++i){
+					assert(offsetsEnd[i] >= offsetsBegin[i]);
+					classSizes.push_back(returnClassSize(i));
+				}
+			}
+
+			//class totals counting each observation by its weight.
+			inline void setVecOfClassWeights(std::vector<int>& classWeights){
+				const uint16_t* obsWeights = indexHolder->returnObsWeights();
+				classWeights.clear();
+				for(int i = 0; i < (int)offsetsEnd.size(); ++i){
+					int classWeight = 0;
+					for(obsIndexIterator q = returnBeginIterator(i); q != returnEndIterator(i); ++q){
+						classWeight += obsWeights[*q];
+					}
+					classWeights.push_back(classWeight);
 				}
 			}
 
-			inline void loadSplitIterator(std::vector<int>::iterator nextIterator){
-				iteratorHolderSplit.push_back(nextIterator);
-				assert(iteratorHolderSplit.back() - iteratorHolderBegin[iteratorHolderSplit.size()-1] >= 0);
-				assert( iteratorHolderEnd[iteratorHolderSplit.size()-1] - iteratorHolderSplit.back() >= 0);
+			inline const uint16_t* returnObsWeights(){
+				return indexHolder->returnObsWeights();
+			}
+
+			inline int returnNumEntries(){
+				int numEntries = 0;
+				for(int i = 0; i < (int)offsetsBegin.size(); ++i){
+					numEntries += returnClassSize(i);
+				}
+				return numEntries;
+			}
+
+			inline void loadSplitIterator(obsIndexIterator nextIterator){
+				const int iterClass = offsetsSplit.size();
+				offsetsSplit.push_back(nextIterator - classBegin(iterClass));
+				assert(offsetsSplit.back() >= offsetsBegin[iterClass]);
+				assert(offsetsEnd[iterClass] >= offsetsSplit.back());
+			}
+
+			inline void resetSplitIterators(){
+				offsetsSplit.clear();
 			}
 
 			inline int returnLeftChildSize(){
 				int leftChildSize = 0;
-				for(int i = 0; i < (int)iteratorHolderBegin.size();++i){
-					assert(iteratorHolderSplit[i]-iteratorHolderBegin[i] >= 0);
-					leftChildSize +=iteratorHolderSplit[i]-iteratorHolderBegin[i]; 
+				for(int i = 0; i < (int)offsetsBegin.size();++i){
+					assert(offsetsSplit[i] >= offsetsBegin[i]);
+					leftChildSize += offsetsSplit[i]-offsetsBegin[i]; 
 				}
 				return leftChildSize;
 			}
@@ -3,22 +3,50 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <assert.h>
 
 namespace fp{
 
+	//observation indices are stored in four bytes, which limits a data
+	//set to 2^32-1 observations.
+	typedef uint32_t obsIndex;
+	typedef std::vector<obsIndex>::iterator obsIndexIterator;
+
 	class obsIndexAndClassVec
 	{
 		protected:
-			std::vector<std::vector<int> > indexHolder;
+			std::vector<std::vector<obsIndex> > indexHolder;
+			//times each observation is in the sample, indexed by observation.
+			//Observations not inserted since the last reset have weight 0.
+			std::vector<uint16_t> obsWeights;
 
 		public:
 			obsIndexAndClassVec(int numClasses):indexHolder(numClasses){}
 
 			inline void insertIndex(int index, int classOfObs){
+				insertIndex(index, classOfObs, 1);
+			}
+
+			inline void insertIndex(int index, int classOfObs, int weight){
+				assert(weight > 0 && weight <= std::numeric_limits<int16_t>::max());
 				indexHolder[classOfObs].push_back(index);
+				if(index >= (int)obsWeights.size()){
+					obsWeights.resize(index+1, 0);
+				}
+				obsWeights[index] = weight;
+			}
+
+			inline int returnObsWeight(int index){
+				return index < (int)obsWeights.size() ? obsWeights[index] : 0;
+			}
+
+			inline const uint16_t* returnObsWeights(){
+				return obsWeights.data();
 			}
 
-			inline std::vector<int>& returnClassVector(int classOfObs){
+			inline std::vector<obsIndex>& returnClassVector(int classOfObs){
 				return indexHolder[classOfObs];
 			}
 
@@ -32,6 +60,7 @@ namespace fp{
 				for(auto& i : indexHolder){
 					i.clear();
 				}
+				std::fill(obsWeights.begin(), obsWeights.end(), 0);
 			}
 
 
@@ -41,7 +70,8 @@ namespace fp{
 			}
 
 			inline void removeObsIndexAndClassVec(){
-			std::vector<std::vector<int> >().swap( indexHolder );
+			std::vector<std::vector<obsIndex> >().swap( indexHolder );
+			std::vector<uint16_t>().swap( obsWeights );
 			}
 
 	};
@@ -0,0 +1,46 @@
+#ifndef oobVoteTally_h
+#define oobVoteTally_h
+
+#include <vector>
+#include <mutex>
+
+namespace fp{
+
+	/*
+	 * The out of bag votes of a whole forest, numObservations x numClasses.
+	 * Bins tally a block of observations at a time and add each block here
+	 * under the lock, so the forest holds one vote matrix however many bins
+	 * it has.
+	 */
+	class oobVoteTally
+	{
+		protected:
+			std::vector<int> votes;
+			std::mutex votesLock;
+
+		public:
+			inline void initialize(const int numObservations, const int numClasses){
+				votes.assign((size_t)numObservations*numClasses, 0);
+			}
+
+			//blockVotes holds the votes of the observations starting at
+			//firstObs, numClasses to an observation.
+			inline void addVotes(const int firstObs, const int numClasses, const std::vector<int>& blockVotes){
+				int* forestVotes = votes.data() + (size_t)firstObs*numClasses;
+				std::lock_guard<std::mutex> lock(votesLock);
+				for(size_t i = 0; i < blockVotes.size(); ++i){
+					forestVotes[i] += blockVotes[i];
+				}
+			}
+
+			inline const std::vector<int>& returnVotes(){
+				return votes;
+			}
+
+			inline void removeVotes(){
+				std::vector<int>().swap(votes);
+			}
+	};
+
+}//namespace fp
+#endif //oobVoteTally_h
@@ -0,0 +1,516 @@
+#ifndef packedBin_h
+#define packedBin_h
+
+#include "binStruct.h"
+#include "../../baseFunctions/forestFile.h"
+#include "forestSource.h"
+#include <vector>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <iostream>
+#include <string>
+
+namespace fp{
+
+	/*
+	 * 16 byte node of a packedBin, two to a 32 byte training node.  left
+	 * and right are node positions in the bin, or -(class+1) for a leaf.
+	 * feature is the feature number of binnedBase nodes and the offset of
+	 * the node's projection in the bin's arena otherwise.
+	 */
+	struct packedNode
+	{
+		float cutValue;
+		int feature;
+		int left;
+		int right;
+
+		inline int nextNode(float featureVal) const{
+			return (featureVal <= cutValue) ? left : right;
+		}
+	};
+
+	static_assert(sizeof(packedNode) == 16, "packedNode must stay 16 bytes.");
+
+
+	//the arrays of a packedBin that owns them.
+	struct packedArrays
+	{
+		std::vector<int> roots;
+		std::vector<packedNode> nodes;
+		std::vector<int> projections;
+	};
+
+
+	/*
+	 * The immutable inference form of a grown bin.  binnedBase packs its
+	 * bins once the forest is grown and predicts only from these.
+	 * Projections are flattened into a single arena per bin, each its
+	 * number of features followed by the features, those subtracted
+	 * stored as ~feature, so traversal never follows a pointer out of the
+	 * node.  Cut values are stored as floats so an observation within
+	 * float rounding of a cut can take the other branch than it would
+	 * have in the training nodes.
+	 *
+	 * The arrays are either the bin's own packedArrays or sections of a
+	 * mapped forest file, used in place.  storage keeps whichever it is
+	 * alive, so copies of a bin share its arrays.
+	 */
+	template <typename T, typename Q>
+		class packedBin
+		{
+			typedef typename accumulatorType<T>::type V;
+
+			protected:
+				int numClasses;
+				int numTrees;
+				std::shared_ptr<const void> storage;
+				const int* roots;
+				const packedNode* nodes;
+				int numNodes;
+				const int* projections;
+				int numProjectionInts;
+
+
+				inline void useArrays(const std::shared_ptr<packedArrays>& arrays){
+					storage = arrays;
+					roots = arrays->roots.data();
+					nodes = arrays->nodes.data();
+					numNodes = (int)arrays->nodes.size();
+					projections = arrays->projections.data();
+					numProjectionInts = (int)arrays->projections.size();
+				}
+
+
+				inline int returnPackedChild(int position){
+					return position < numClasses ? -(position+1) : position-numClasses;
+				}
+
+
+				inline int packFeature(int& feature, std::vector<int>&){
+					return feature;
+				}
+
+				inline int packFeature(std::vector<int>& features, std::vector<int>& projectionArena){
+					const int offset = (int)projectionArena.size();
+					projectionArena.push_back((int)features.size());
+					projectionArena.insert(projectionArena.end(), features.begin(), features.end());
+					return offset;
+				}
+
+				inline int packFeature(weightedFeature& features, std::vector<int>& projectionArena){
+					const int offset = (int)projectionArena.size();
+					projectionArena.push_back((int)features.returnFeatures().size());
+					for(int i = 0; i < (int)features.returnFeatures().size(); ++i){
+						if(features.returnWeights()[i] == 1){
+							projectionArena.push_back(features.returnFeatures()[i]);
+						}else if(features.returnWeights()[i] == -1){
+							projectionArena.push_back(~features.returnFeatures()[i]);
+						}else{
+							throw std::runtime_error("packedBin only stores projections with weights of 1 and -1.");
+						}
+					}
+					return offset;
+				}
+
+
+				template <typename A>
+					inline float projectObservation(const A& data, const packedNode& node, int obs) const{
+						if(std::is_same<Q,int>::value){
+							return (float)data.returnFeatureValue(node.feature, obs);
+						}
+						const int* projection = projections + node.feature;
+						const int* projectionEnd = projection + 1 + projection[0];
+						V featureVal = 0;
+						for(++projection; projection < projectionEnd; ++projection){
+							if(*projection >= 0){
+								featureVal += data.returnFeatureValue(*projection, obs);
+							}else{
+								featureVal -= data.returnFeatureValue(~*projection, obs);
+							}
+						}
+						return (float)featureVal;
+					}
+
+				//the node's projection of observation x, in the order and type
+				//projectObservation sums it.
+				inline void writeProjectionSource(std::ostream& source, const packedNode& node) const{
+					if(std::is_same<Q,int>::value){
+						source << "(float)x(" << node.feature << ")";
+						return;
+					}
+					const int* projection = projections + node.feature;
+					source << "(float)((V)0";
+					for(int i = 1; i <= projection[0]; ++i){
+						if(projection[i] >= 0){
+							source << " + x(" << projection[i] << ")";
+						}else{
+							source << " - x(" << ~projection[i] << ")";
+						}
+					}
+					source << ")";
+				}
+
+
+				inline void writeNodeSource(std::ostream& source, int node, int depth) const{
+					if(node < 0){
+						source << std::string(depth, '\t') << "return " << -node-1 << ";\n";
+						return;
+					}
+					source << std::string(depth, '\t') << "if(";
+					writeProjectionSource(source, nodes[node]);
+					source << " <= " << returnFloatLiteral(nodes[node].cutValue) << "){\n";
+					writeNodeSource(source, nodes[node].left, depth+1);
+					source << std::string(depth, '\t') << "}else{\n";
+					writeNodeSource(source, nodes[node].right, depth+1);
+					source << std::string(depth, '\t') << "}\n";
+				}
+
+
+				//the child to lay out next to node: the more visited of its
+				//internal children, the left on a tie.
+				inline int returnHotChild(const std::vector<int>& visits, int node) const{
+					const packedNode& parent = nodes[node];
+					if(parent.right >= 0 && (parent.left < 0 || visits[parent.right] > visits[parent.left])){
+						return parent.right;
+					}
+					return parent.left;
+				}
+
+
+				inline int returnColdChild(const std::vector<int>& visits, int node) const{
+					const packedNode& parent = nodes[node];
+					return returnHotChild(visits, node) == parent.left ? parent.right : parent.left;
+				}
+
+				//child is a node after parent, so traversal always ends, or a
+				//leaf of one of the classes.
+				inline bool isValidChild(int child, int parent) const{
+					return child < 0 ? -child-1 < numClasses : parent < child && child < numNodes;
+				}
+
+
+				inline bool isValidFeature(int feature, int numFeatureValues) const{
+					return 0 <= feature && feature < numFeatureValues;
+				}
+
+
+				inline bool isValidProjection(int offset, int numFeatureValues) const{
+					if(offset < 0 || offset >= numProjectionInts || projections[offset] < 0 || projections[offset] > numProjectionInts-offset-1){
+						return false;
+					}
+					for(int i = offset+1; i <= offset+projections[offset]; ++i){
+						if(!isValidFeature(projections[i] >= 0 ? projections[i] : ~projections[i], numFeatureValues)){
+							return false;
+						}
+					}
+					return true;
+				}
+
+
+				//a bin read from a file is used as is, so every position
+				//traversal reads from it has to be in range.  Only nodes a
+				//root reaches are read.
+				inline void checkLoadedNodes(int numFeatureValues) const{
+					std::vector<bool> reached(numNodes, false);
+					for(int q = 0; q < numTrees; ++q){
+						if(!isValidChild(roots[q], -1)){
+							throw std::runtime_error("saved bin has a root out of range.");
+						}
+						if(roots[q] >= 0){
+							reached[roots[q]] = true;
+						}
+					}
+					for(int node = 0; node < numNodes; ++node){
+						if(!reached[node]){
+							continue;
+						}
+						if(!isValidChild(nodes[node].left, node) || !isValidChild(nodes[node].right, node)){
+							throw std::runtime_error("saved bin has a child out of range.");
+						}
+						if(std::is_same<Q,int>::value ? !isValidFeature(nodes[node].feature, numFeatureValues) : !isValidProjection(nodes[node].feature, numFeatureValues)){
+							throw std::runtime_error("saved bin has a feature out of range.");
+						}
+						if(nodes[node].left >= 0){
+							reached[nodes[node].left] = true;
+						}
+						if(nodes[node].right >= 0){
+							reached[nodes[node].right] = true;
+						}
+					}
+				}
+
+			public:
+				packedBin(binStruct<T,Q>& bin, int numberOfClasses) : numClasses(numberOfClasses), numTrees(bin.returnNumTrees()){
+					std::vector< fpBaseNode<V,Q> >& grownNodes = bin.returnNodes();
+					std::shared_ptr<packedArrays> arrays = std::make_shared<packedArrays>();
+					arrays->nodes.resize(grownNodes.size()-numClasses);
+					arrays->roots.resize(numTrees);
+					for(int position = numClasses; position < (int)grownNodes.size(); ++position){
+						fpBaseNode<V,Q>& grownNode = grownNodes[position];
+						packedNode& node = arrays->nodes[position-numClasses];
+						if(grownNode.isInternalNodeFront()){
+							node.cutValue = (float)grownNode.returnCutValue();
+							node.feature = packFeature(grownNode.returnFeatureNumber(), arrays->projections);
+							node.left = returnPackedChild(grownNode.returnLeftNodeID());
+							node.right = returnPackedChild(grownNode.returnRightNodeID());
+						}else{
+							//a root that is a leaf.
+							node.cutValue = 0;
+							node.feature = 0;
+							node.left = node.right = -(grownNode.returnClass()+1);
+						}
+					}
+					for(int tree = 0; tree < numTrees; ++tree){
+						arrays->roots[tree] = grownNodes[tree+numClasses].isInternalNodeFront() ? tree : -(grownNodes[tree+numClasses].returnClass()+1);
+					}
+					arrays->projections.shrink_to_fit();
+					useArrays(arrays);
+				}
+
+
+				//reads a bin written by saveBin, its arrays used in place.
+				//numFeatureValues is the number of values a node's features
+				//index, the features or the summed area table entries.
+				packedBin(forestFileReader& forestFile, int numberOfClasses, int numFeatureValues) : numClasses(numberOfClasses), storage(forestFile.returnFile()){
+					size_t count;
+					numTrees = forestFile.readValue<int32_t>();
+					roots = forestFile.readSection<int>(count);
+					if(numTrees < 0 || count != (size_t)numTrees){
+						throw std::runtime_error("saved bin has the wrong number of roots.");
+					}
+					nodes = forestFile.readSection<packedNode>(count);
+					if(count > (size_t)std::numeric_limits<int>::max()){
+						throw std::runtime_error("saved bin has too many nodes.");
+					}
+					numNodes = (int)count;
+					projections = forestFile.readSection<int>(count);
+					if(count > (size_t)std::numeric_limits<int>::max()){
+						throw std::runtime_error("saved bin has too many projection features.");
+					}
+					numProjectionInts = (int)count;
+					checkLoadedNodes(numFeatureValues);
+				}
+
+
+				inline void saveBin(forestFileWriter& forestFile) const{
+					forestFile.writeValue((int32_t)numTrees);
+					forestFile.writeSection(roots, numTrees);
+					forestFile.writeSection(nodes, numNodes);
+					forestFile.writeSection(projections, numProjectionInts);
+				}
+
+
+				inline int returnNumTrees() const{
+					return numTrees;
+				}
+
+
+				//memory read when traversing the bin.
+				inline size_t returnNumBytes() const{
+					return numNodes*sizeof(packedNode) + numProjectionInts*sizeof(int) + numTrees*sizeof(int);
+				}
+
+
+				inline const packedNode* returnNodes() const{
+					return nodes;
+				}
+
+
+				inline int returnNumNodes() const{
+					return numNodes;
+				}
+
+
+				inline const int* returnRoots() const{
+					return roots;
+				}
+
+
+				//the number of observations 0 to numObservations-1 of data that
+				//pass through each node.
+				template <typename A>
+					inline std::vector<int> returnNodeVisits(const A& data, int numObservations) const{
+						std::vector<int> visits(numNodes, 0);
+						for(int obs = 0; obs < numObservations; ++obs){
+							for(int q = 0; q < numTrees; ++q){
+								for(int node = roots[q]; node >= 0; node = nodes[node].nextNode(projectObservation(data, nodes[node], obs))){
+									++visits[node];
+								}
+							}
+						}
+						return visits;
+					}
+
+
+				//lays the nodes out in the order observations reach them, as
+				//the forestPacking bins do.  The top depthIntertwined levels
+				//of every tree are interleaved a level at a time so the trees'
+				//first loads share cache lines, then each remaining subtree
+				//is laid out depth first with the more visited child of a node
+				//right behind it.  Leaf roots, which no traversal reads, are
+				//dropped.
+				inline void reorderNodes(const std::vector<int>& visits, int depthIntertwined){
+					std::vector<int> order;
+					order.reserve(numNodes);
+					std::vector<int> level;
+					std::vector<int> nextLevel;
+					for(int q = 0; q < numTrees; ++q){
+						if(roots[q] >= 0){
+							level.push_back(roots[q]);
+						}
+					}
+
+					for(int depth = 0; depth < depthIntertwined && !level.empty(); ++depth){
+						nextLevel.clear();
+						for(int node : level){
+							order.push_back(node);
+							const int hotChild = returnHotChild(visits, node);
+							const int coldChild = returnColdChild(visits, node);
+							if(hotChild >= 0){
+								nextLevel.push_back(hotChild);
+							}
+							if(coldChild >= 0){
+								nextLevel.push_back(coldChild);
+							}
+						}
+						level.swap(nextLevel);
+					}
+
+					std::vector<int> subtreeStack;
+					for(int subtreeRoot : level){
+						subtreeStack.push_back(subtreeRoot);
+						while(!subtreeStack.empty()){
+							const int node = subtreeStack.back();
+							subtreeStack.pop_back();
+							order.push_back(node);
+							if(returnColdChild(visits, node) >= 0){
+								subtreeStack.push_back(returnColdChild(visits, node));
+							}
+							if(returnHotChild(visits, node) >= 0){
+								subtreeStack.push_back(returnHotChild(visits, node));
+							}
+						}
+					}
+
+					std::vector<int> newPosition(numNodes, -1);
+					for(int position = 0; position < (int)order.size(); ++position){
+						newPosition[order[position]] = position;
+					}
+					std::shared_ptr<packedArrays> arrays = std::make_shared<packedArrays>();
+					arrays->nodes.resize(order.size());
+					for(int position = 0; position < (int)order.size(); ++position){
+						packedNode& node = arrays->nodes[position];
+						node = nodes[order[position]];
+						node.left = node.left < 0 ? node.left : newPosition[node.left];
+						node.right = node.right < 0 ? node.right : newPosition[node.right];
+					}
+					arrays->roots.resize(numTrees);
+					for(int q = 0; q < numTrees; ++q){
+						arrays->roots[q] = roots[q] < 0 ? roots[q] : newPosition[roots[q]];
+					}
+					arrays->projections.assign(projections, projections+numProjectionInts);
+					useArrays(arrays);
+				}
+
+
+				template <typename A>
+					inline void reorderNodes(const A& data, int numObservations, int depthIntertwined){
+						reorderNodes(returnNodeVisits(data, numObservations), depthIntertwined);
+					}
+
+
+				//adds the votes of the bin's trees for observation obs of data to
+				//votes.  Every tree advances a level per pass so the loads of the
+				//different trees overlap.
+				template <typename A>
+					inline void predictObservation(const A& data, int obs, int* votes) const{
+						std::vector<int> currNode(roots, roots+numTrees);
+						int numberNotInLeaf;
+						int q;
+
+						do{
+							numberNotInLeaf = 0;
+							for( q=0; q<numTrees; ++q){
+								if(currNode[q] >= 0){
+									currNode[q] = nodes[currNode[q]].nextNode(projectObservation(data, nodes[currNode[q]], obs));
+									if(currNode[q] >= 0){
+										__builtin_prefetch(&nodes[currNode[q]], 0, 3);
+									}
+									++numberNotInLeaf;
+								}
+							}
+						}while(numberNotInLeaf);
+
+						for( q=0; q<numTrees; q++){
+							++votes[-currNode[q]-1];
+						}
+					}
+
+
+				//adds the votes of the bin's trees for observations firstObs to
+				//firstObs+numObs-1 of data to votes, numClasses per observation.
+				//
+				//groupSize observations are traversed together: each pass
+				//advances every (observation, tree) pair not yet in a leaf one
+				//level and prefetches its next node, which has a whole pass of
+				//other pairs to arrive in.
+				template <typename A>
+					inline void predictTile(const A& data, int firstObs, int numObs, int groupSize, int* votes) const{
+						std::vector<int> currNode((size_t)groupSize*numTrees);
+						std::vector<int> pairObs(currNode.size());
+
+						for(int groupStart = firstObs; groupStart < firstObs+numObs; groupStart += groupSize){
+							const int groupEnd = std::min(groupStart+groupSize, firstObs+numObs);
+							int numPairs = 0;
+							for(int obs = groupStart; obs < groupEnd; ++obs){
+								for(int q = 0; q < numTrees; ++q){
+									currNode[numPairs] = roots[q];
+									pairObs[numPairs] = obs;
+									++numPairs;
+								}
+							}
+
+							int numberNotInLeaf;
+							do{
+								numberNotInLeaf = 0;
+								for(int p = 0; p < numPairs; ++p){
+									if(currNode[p] >= 0){
+										currNode[p] = nodes[currNode[p]].nextNode(projectObservation(data, nodes[currNode[p]], pairObs[p]));
+										if(currNode[p] >= 0){
+											__builtin_prefetch(&nodes[currNode[p]], 0, 3);
+										}
+										++numberNotInLeaf;
+									}
+								}
+							}while(numberNotInLeaf);
+
+							for(int p = 0; p < numPairs; ++p){
+								++votes[(size_t)(pairObs[p]-firstObs)*numClasses - currNode[p] - 1];
+							}
+						}
+					}
+
+
+				//writes tree q of the bin as a function of an observation x,
+				//x(feature) returning its value, that returns the tree's class.
+				inline void writeTreeSource(std::ostream& source, int q, const std::string& functionName) const{
+					source << "template <typename A>\n";
+					source << "inline int " << functionName << "(const A& x){\n";
+					writeNodeSource(source, roots[q], 1);
+					source << "}\n\n";
+				}
+
+
+				void printBin() const{
+					std::cout << "\n";
+					for(const packedNode* node = nodes; node < nodes+numNodes; ++node){
+						std::cout << "cutValue " << node->cutValue << ", feature " << node->feature << ", left " << node->left << ", right " << node->right << "\n";
+					}
+				}
+		};
+
+}//fp
+#endif //packedBin_h
@@ -7,11 +7,15 @@
 #include "bestSplitInfo.h"
 #include "nodeIterators.h"
 #include "zipperIterators.h"
+#include "sparseProjection.h"
+#include "summedAreaTable.h"
 #include <assert.h>
-#include "../../fpSingleton/fpSingleton.h"
+#include "../../fpSingleton/fpContext.h"
 #include "../../baseFunctions/pdqsort.h"
+#include "../../baseFunctions/radixSort.h"
 #include "../../baseFunctions/MWC.h"
 #include "../../baseFunctions/weightedFeature.h"
+#include "../../baseFunctions/accumulatorType.h"
 
 
 #include <iostream>
@@ -19,12 +23,16 @@
 #include <algorithm>
 #include <limits>
 #include <random>
+#include <type_traits>
 
 namespace fp{
 
 	template<typename T, typename Q>
 		class processingNodeBin{
 			protected:
+				//values are stored as T but summed and compared as V.
+				typedef typename accumulatorType<T>::type V;
+
 				int treeNum;
 				int parentNodeNumber;
 				int depth;
@@ -34,7 +42,7 @@ namespace fp{
 				bool leafNode;
 
 				std::vector<Q> mtry;
-				bestSplitInfo<T, Q> bestSplit;
+				bestSplitInfo<V, Q> bestSplit;
 
 				inNodeClassTotals propertiesOfThisNode;
 				inNodeClassTotals propertiesOfLeftNode;
@@ -42,11 +50,39 @@ namespace fp{
 
 				nodeIterators nodeIndices;
 
-				zipperIterators<int,T> zipIters;
+				zipperIterators<int,V> zipIters;
 
 				randomNumberRerFMWC* randNum;
+				fpContext* context;
+
+				//scratch space for histogram split mode.
+				std::vector<zipClassAndValue<int,V> > histogramSample;
+				std::vector<V> histogramCuts;
+				std::vector<int> histogram;
+
+				//scratch space for radix sorting the working set.
+				std::vector<zipClassAndValue<int,V> > sortBuffer;
+
+				//the bin's projection cache: two halves of one value per
+				//observation, addressed like the zipper.  bestProjection is the
+				//half holding the best candidate's values, -1 if none.
+				V* projectionCache;
+				int projectionCacheSize;
+				int bestProjection;
+				bool cacheProjections;
+
+				//the candidate being loaded or partitioned, split by sign, and
+				//the values of the block of observations it last projected.
+				sparseProjection<V> projection;
+				std::vector<V> projectedValues;
+
+				//the forest's summed area tables, one row per observation, when
+				//structured RerF patches index them rather than the pixels.
+				const T* summedAreaTables;
+
 				inline void calcMtryForNode(std::vector<int>& featuresToTry){
-					for (int i=0; i<fpSingleton::getSingleton().returnNumFeatures(); ++i){
+					featuresToTry.clear();
+					for (int i=0; i<context->returnNumFeatures(); ++i){
 						featuresToTry.push_back(i);
 					}
 
@@ -54,33 +90,42 @@ namespace fp{
 
 					// This is an efficient way to shuffle the first "mtry" elements of the feature vector
 					// in order to sample features w/o replacement.
-					for(int locationToMove = 0; locationToMove < fpSingleton::getSingleton().returnMtry(); locationToMove++){
-						int randomPosition = randNum->gen(fpSingleton::getSingleton().returnNumFeatures()-locationToMove)+locationToMove;
+					for(int locationToMove = 0; locationToMove < context->returnMtry(); locationToMove++){
+						int randomPosition = randNum->gen(context->returnNumFeatures()-locationToMove)+locationToMove;
 						tempSwap = featuresToTry[locationToMove];
 						featuresToTry[locationToMove] = featuresToTry[randomPosition];
 						featuresToTry[randomPosition] = tempSwap;
 					}
 
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					featuresToTry.resize(context->returnMtry());
 				}
 
 
 				inline void calcMtryForNode(std::vector<std::vector<int> >& featuresToTry){
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					//inner vectors are cleared rather than freed so a recycled
+					//node keeps their storage.
+					featuresToTry.resize(context->returnMtry());
+					for(auto& feature : featuresToTry){
+						feature.clear();
+					}
 					int rndMtry;
 					int rndFeature;
-					int mtryDensity = (int)((double)fpSingleton::getSingleton().returnMtry() * fpSingleton::getSingleton().returnMtryMult());
+					int mtryDensity = (int)((double)context->returnMtry() * context->returnMtryMult());
 					for (int i = 0; i < mtryDensity; ++i){
-						rndMtry = randNum->gen(fpSingleton::getSingleton().returnMtry());
-						rndFeature = randNum->gen(fpSingleton::getSingleton().returnNumFeatures());
+						rndMtry = randNum->gen(context->returnMtry());
+						rndFeature = randNum->gen(context->returnNumFeatures());
 						featuresToTry[rndMtry].push_back(rndFeature);
 					}
 				}
 
 
 				inline void calcMtryForNode(std::vector<weightedFeature>& featuresToTry){
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
-					int methodToUse = fpSingleton::getSingleton().returnMethodToUse();
+					featuresToTry.resize(context->returnMtry());
+					for(auto& feature : featuresToTry){
+						feature.returnFeatures().clear();
+						feature.returnWeights().clear();
+					}
+					int methodToUse = context->returnMethodToUse();
 					assert(methodToUse == 1 || methodToUse == 2);
 
 					switch(methodToUse){
@@ -100,10 +145,10 @@ namespace fp{
 					int rndMtry;
 					int rndFeature;
 					int rndWeight;
-					int mtryDensity = (int)((double)fpSingleton::getSingleton().returnMtry() * fpSingleton::getSingleton().returnMtryMult());
+					int mtryDensity = (int)((double)context->returnMtry() * context->returnMtryMult());
 					for (int i = 0; i < mtryDensity; ++i){
-						rndMtry = randNum->gen(fpSingleton::getSingleton().returnMtry());
-						rndFeature = randNum->gen(fpSingleton::getSingleton().returnNumFeatures());
+						rndMtry = randNum->gen(context->returnMtry());
+						rndFeature = randNum->gen(context->returnNumFeatures());
 						featuresToTry[rndMtry].returnFeatures().push_back(rndFeature);
 						rndWeight = (randNum->gen(2)%2) ? 1 : -1;
 						assert(rndWeight==1 || rndWeight==-1);
@@ -114,17 +159,17 @@ namespace fp{
 
 				inline std::vector<std::vector<int> > paramsRandMatImagePatch(){
 					// Preset parameters
-					const int& imageHeight = fpSingleton::getSingleton().returnImageHeight();
-					const int& imageWidth = fpSingleton::getSingleton().returnImageWidth();
+					const int& imageHeight = context->returnImageHeight();
+					const int& imageWidth = context->returnImageWidth();
 
-					const int& patchHeightMax = fpSingleton::getSingleton().returnPatchHeightMax();
-					const int& patchHeightMin = fpSingleton::getSingleton().returnPatchHeightMin();
-					const int& patchWidthMax  = fpSingleton::getSingleton().returnPatchWidthMax();
-					const int& patchWidthMin  = fpSingleton::getSingleton().returnPatchWidthMin();
+					const int& patchHeightMax = context->returnPatchHeightMax();
+					const int& patchHeightMin = context->returnPatchHeightMin();
+					const int& patchWidthMax  = context->returnPatchWidthMax();
+					const int& patchWidthMin  = context->returnPatchWidthMin();
 
 					// A vector of vectors that specifies the parameters
 					// for each patch: < <Height>, <Width>, <TopLeft> >
-					std::vector<std::vector<int> > heightWidthTop(3, std::vector<int>(fpSingleton::getSingleton().returnMtry()));
+					std::vector<std::vector<int> > heightWidthTop(3, std::vector<int>(context->returnMtry()));
 
 					int deltaH;
 					int deltaW;
@@ -133,7 +178,7 @@ namespace fp{
 
 					// Loop over mtry to load random patch dimensions
 					// and top left position.
-					for (int k = 0; k < fpSingleton::getSingleton().returnMtry(); k++){
+					for (int k = 0; k < context->returnMtry(); k++){
 
 						heightWidthTop[0][k] = randNum->gen(patchHeightMax - patchHeightMin + 1) + patchHeightMin; //sample from [patchHeightMin, patchHeightMax]
 						heightWidthTop[1][k] = randNum->gen(patchWidthMax - patchWidthMin + 1) +  patchWidthMin;    //sample from [patchWidthMin, patchWidthMax]
@@ -158,13 +203,22 @@ namespace fp{
 
 
 				inline void randMatImagePatch(std::vector<weightedFeature>& featuresToTry, std::vector<std::vector<int> > patchPositions){
-					assert((int)(patchPositions[0].size()) == fpSingleton::getSingleton().returnMtry());
+					assert((int)(patchPositions[0].size()) == context->returnMtry());
 
 					// Preset parameters
-					const int& imageWidth = fpSingleton::getSingleton().returnImageWidth();
+					const int& imageWidth = context->returnImageWidth();
+
+					//patches index the summed area tables whenever the node
+					//reads from them.
+					if(summedAreaTables != NULL){
+						for (int k = 0; k < context->returnMtry(); k++){
+							summedAreaTable::setPatch(featuresToTry[k], patchPositions[2][k], patchPositions[0][k], patchPositions[1][k], imageWidth);
+						}
+						return;
+					}
 
 					int pixelIndex = -1;
-					for (int k = 0; k < fpSingleton::getSingleton().returnMtry(); k++){
+					for (int k = 0; k < context->returnMtry(); k++){
 						for (int row = 0; row < patchPositions[0][k]; row++) {
 							for (int col = 0; col < patchPositions[1][k]; col++) {
 								pixelIndex = patchPositions[2][k] + col + (imageWidth * row);
@@ -191,9 +245,9 @@ namespace fp{
 
 					double tempImpurity;
 					double currentBestImpurity =  bestSplit.returnImpurity();
-					for(typename std::vector<zipClassAndValue<int,T> >::iterator it = zipIters.returnZipBegin(); it < zipIters.returnZipEnd()-1; ++it){
-						propertiesOfLeftNode.incrementClass(it->returnObsClass());
-						propertiesOfRightNode.decrementClass(it->returnObsClass());
+					for(typename std::vector<zipClassAndValue<int,V> >::iterator it = zipIters.returnZipBegin(); it < zipIters.returnZipEnd()-1; ++it){
+						propertiesOfLeftNode.addToClass(it->returnObsClass(), it->returnObsWeight());
+						propertiesOfRightNode.removeFromClass(it->returnObsClass(), it->returnObsWeight());
 
 						if(it->checkInequality(*(it+1))){
 							tempImpurity = propertiesOfLeftNode.calcAndReturnImpurity() + propertiesOfRightNode.calcAndReturnImpurity();
@@ -210,150 +264,240 @@ namespace fp{
 				}
 
 
-				inline void setRootNodeIndices(obsIndexAndClassVec& indexHolder){
-					nodeIndices.setInitialIterators(indexHolder);
+				/*
+				 * Histogram split mode.  Rather than sorting the working set the
+				 * cut points are taken from the quantiles of a small sorted
+				 * sample of it, class counts are accumulated per bin in one pass,
+				 * and only the bin boundaries are tried.  Cut points are per
+				 * node and per candidate because candidates are drawn (and
+				 * projected) fresh at every node.
+				 */
+				inline bool useHistogramSplit(){
+					return context->returnNumHistogramBins() && returnNodeSize() > context->returnNumHistogramBins()*globalHistogramSamplesPerBin;
 				}
 
-				inline void setRootNodeZipIters(typename std::vector<zipClassAndValue<int,T> >& zipper){
-					zipIters.setZipIteratorsRoot(zipper);
+
+				inline void setHistogramCuts(){
+					const int numBins = context->returnNumHistogramBins();
+					const int sampleSize = numBins*globalHistogramSamplesPerBin;
+					const int nodeSize = returnNodeSize();
+
+					histogramSample.resize(sampleSize);
+					for(auto& sample : histogramSample){
+						sample = *(zipIters.returnZipBegin()+randNum->gen(nodeSize));
+					}
+					pdqsort_branchless(histogramSample.begin(), histogramSample.end());
+
+					//a boundary inside a run of equal values moves to the end of
+					//the run so features with few distinct values keep their cuts.
+					histogramCuts.clear();
+					int lastBoundary = 0;
+					for(int binNum = 1; binNum < numBins; ++binNum){
+						int boundary = std::max(binNum*sampleSize/numBins, lastBoundary+1);
+						while(boundary < sampleSize && !histogramSample[boundary-1].checkInequality(histogramSample[boundary])){
+							++boundary;
+						}
+						if(boundary >= sampleSize){
+							break;
+						}
+						histogramCuts.push_back(histogramSample[boundary-1].midVal(histogramSample[boundary]));
+						lastBoundary = boundary;
+					}
 				}
 
 
-				inline void loadWorkingSet(int currMTRY){
-					typename std::vector<zipClassAndValue<int,T> >::iterator zipIterator = zipIters.returnZipBegin();
-					for(int classNum = 0; classNum < fpSingleton::getSingleton().returnNumClasses(); ++classNum){
+				inline void findBestHistogramSplit(Q& currMtry){
+					const int numClasses = context->returnNumClasses();
+					const int numCuts = histogramCuts.size();
 
-						int sizeToPrefetch = globalPrefetchSize;            
-						if(nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum) < 32){ 
-							sizeToPrefetch = nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum);
-						}
+					//bin b holds values in (cut[b-1], cut[b]], matching the
+					//value <= splitValue test used to partition the node.
+					histogram.assign((numCuts+1)*numClasses, 0);
+					for(typename std::vector<zipClassAndValue<int,V> >::iterator it = zipIters.returnZipBegin(); it < zipIters.returnZipEnd(); ++it){
+						int binNum = std::lower_bound(histogramCuts.begin(), histogramCuts.end(), it->returnFeatureVal()) - histogramCuts.begin();
+						histogram[binNum*numClasses + it->returnObsClass()] += it->returnObsWeight();
+					}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnBeginIterator(classNum)+sizeToPrefetch; ++q){
-							fpSingleton::getSingleton().prefetchFeatureVal(currMTRY,*q);
-						}
+					resetLeftNode();
+					resetRightNode();
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; ++q){
-							fpSingleton::getSingleton().prefetchFeatureVal(currMTRY,*(q+sizeToPrefetch));
-							zipIterator->setPair(classNum, fpSingleton::getSingleton().returnFeatureVal(currMTRY,*q));
-							++zipIterator;
+					double tempImpurity;
+					double currentBestImpurity =  bestSplit.returnImpurity();
+					for(int binNum = 0; binNum < numCuts; ++binNum){
+						for(int classNum = 0; classNum < numClasses; ++classNum){
+							propertiesOfLeftNode.addToClass(classNum, histogram[binNum*numClasses + classNum]);
+							propertiesOfRightNode.removeFromClass(classNum, histogram[binNum*numClasses + classNum]);
 						}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; q!=nodeIndices.returnEndIterator(classNum); ++q){
-							zipIterator->setPair(classNum, fpSingleton::getSingleton().returnFeatureVal(currMTRY,*q));
-							++zipIterator;
+						if(propertiesOfLeftNode.returnNumItems() && propertiesOfRightNode.returnNumItems()){
+							tempImpurity = propertiesOfLeftNode.calcAndReturnImpurity() + propertiesOfRightNode.calcAndReturnImpurity();
+
+							if(tempImpurity < bestSplit.returnImpurity()){
+								bestSplit.setImpurity(tempImpurity);
+								bestSplit.setSplitValue(histogramCuts[binNum]);
+							}
 						}
+					}
+					if(bestSplit.returnImpurity() < currentBestImpurity){
+						bestSplit.setFeature(currMtry);
+					}
+				}
 
-					}	
+
+				inline void setRootNodeIndices(obsIndexAndClassVec& indexHolder){
+					nodeIndices.setInitialIterators(indexHolder);
 				}
 
+				inline void setRootNodeZipIters(typename std::vector<zipClassAndValue<int,V> >& zipper){
+					zipIters.setZipIteratorsRoot(zipper, returnNodeSize());
+				}
 
 
-				inline void loadWorkingSet(std::vector<int>& currMTRY){
+				/*
+				 * The working set loaders and the index partition below read X
+				 * through an accessor so the hot loops inline a strided load
+				 * rather than calling through fpData.  The one argument
+				 * versions pick the accessor for the data's layout, or for the
+				 * summed area tables when patches index those.
+				 */
+				template <typename M>
+				inline void loadWorkingSet(M& currMTRY){
+					if(summedAreaTables != NULL){
+						loadWorkingSet(returnSummedAreaTableAccessor(), currMTRY);
+					}else if(context->dataIsRowMajor()){
+						loadWorkingSet(context->returnRowMajorAccessor<T>(), currMTRY);
+					}else{
+						loadWorkingSet(context->returnColMajorAccessor<T>(), currMTRY);
+					}
+				}
+
 
-					typename std::vector<zipClassAndValue<int,T> >::iterator zipIterator = zipIters.returnZipBegin();
-					T accumulator;
+				template <typename A>
+				inline void loadWorkingSet(const A& data, int currMTRY){
+					typename std::vector<zipClassAndValue<int,V> >::iterator zipIterator = zipIters.returnZipBegin();
+					const uint16_t* obsWeights = nodeIndices.returnObsWeights();
+					for(int classNum = 0; classNum < context->returnNumClasses(); ++classNum){
 
-					for(int classNum = 0; classNum < fpSingleton::getSingleton().returnNumClasses(); ++classNum){
+						const obsIndexIterator classBegin = nodeIndices.returnBeginIterator(classNum);
+						const obsIndexIterator classEnd = nodeIndices.returnEndIterator(classNum);
 
 						int sizeToPrefetch = globalPrefetchSize;            
-						if(nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum) < 32){ 
-							sizeToPrefetch = nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum);
+						if(classEnd - classBegin < 32){ 
+							sizeToPrefetch = classEnd - classBegin;
 						}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnBeginIterator(classNum)+sizeToPrefetch; ++q){
-							for(auto i : currMTRY){
-								fpSingleton::getSingleton().prefetchFeatureVal(i,*q);
-							}
+						for(obsIndexIterator q=classBegin; q!=classBegin+sizeToPrefetch; ++q){
+							data.prefetchFeatureValue(currMTRY,*q);
 						}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; ++q){
-							accumulator=0;
-							for(auto i : currMTRY){
-								fpSingleton::getSingleton().prefetchFeatureVal(i,*(q+sizeToPrefetch));
-								accumulator+= fpSingleton::getSingleton().returnFeatureVal(i,*q);
-							}
-							zipIterator->setPair(classNum,accumulator);
+						for(obsIndexIterator q=classBegin; q!=classEnd-sizeToPrefetch; ++q){
+							data.prefetchFeatureValue(currMTRY,*(q+sizeToPrefetch));
+							zipIterator->setPair(classNum, data.returnFeatureValue(currMTRY,*q), obsWeights[*q]);
 							++zipIterator;
 						}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; q!=nodeIndices.returnEndIterator(classNum); ++q){
-							accumulator=0;
-							for(auto i : currMTRY){
-								accumulator+= fpSingleton::getSingleton().returnFeatureVal(i,*q);
-							}
-							zipIterator->setPair(classNum,accumulator);
+						for(obsIndexIterator q=classEnd-sizeToPrefetch; q!=classEnd; ++q){
+							zipIterator->setPair(classNum, data.returnFeatureValue(currMTRY,*q), obsWeights[*q]);
 							++zipIterator;
 						}
 
-					}
+					}	
 				}
 
 
-				inline void loadWorkingSet(weightedFeature& currMTRY){
 
-					typename std::vector<zipClassAndValue<int,T> >::iterator zipIterator = zipIters.returnZipBegin();
-					T accumulator;
-					int weightNum;
+				template <typename A>
+				inline void loadWorkingSet(const A& data, std::vector<int>& currMTRY){
+					projection.setProjection(currMTRY);
+					loadProjectedWorkingSet(data);
+				}
 
-					for(int classNum = 0; classNum < fpSingleton::getSingleton().returnNumClasses(); ++classNum){
 
-						int sizeToPrefetch = globalPrefetchSize;            
-						if(nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum) < 32){ 
-							sizeToPrefetch = nodeIndices.returnEndIterator(classNum) - nodeIndices.returnBeginIterator(classNum);
-						}
+				template <typename A>
+				inline void loadWorkingSet(const A& data, weightedFeature& currMTRY){
+					projection.setProjection(currMTRY);
+					loadProjectedWorkingSet(data);
+				}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnBeginIterator(classNum)+sizeToPrefetch; ++q){
-							for(auto i : currMTRY.returnFeatures()){
-								fpSingleton::getSingleton().prefetchFeatureVal(i,*q);
-							}
-						}
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; ++q){
-							accumulator=0;
-							weightNum = 0;
-							for(auto i : currMTRY.returnFeatures()){
-								fpSingleton::getSingleton().prefetchFeatureVal(i,*(q+sizeToPrefetch));
-								accumulator+= fpSingleton::getSingleton().returnFeatureVal(i,*q)*currMTRY.returnWeights()[weightNum++];
-							}
-							zipIterator->setPair(classNum,accumulator);
-							++zipIterator;
-						}
+				//projects a block of a class's observations at a time.
+				template <typename A>
+				inline void loadProjectedWorkingSet(const A& data){
+
+					typename std::vector<zipClassAndValue<int,V> >::iterator zipIterator = zipIters.returnZipBegin();
+					const uint16_t* obsWeights = nodeIndices.returnObsWeights();
+					projectedValues.resize(globalProjectionBlockSize);
+
+					for(int classNum = 0; classNum < context->returnNumClasses(); ++classNum){
 
-						for(std::vector<int>::iterator q=nodeIndices.returnEndIterator(classNum)-sizeToPrefetch; q!=nodeIndices.returnEndIterator(classNum); ++q){
-							accumulator=0;
-							weightNum = 0;
-							for(auto i : currMTRY.returnFeatures()){
-								accumulator+= fpSingleton::getSingleton().returnFeatureVal(i,*q)*currMTRY.returnWeights()[weightNum++];
+						const obsIndexIterator classBegin = nodeIndices.returnBeginIterator(classNum);
+						const obsIndexIterator classEnd = nodeIndices.returnEndIterator(classNum);
+
+						const int classSize = classEnd - classBegin;
+						for(int blockStart = 0; blockStart < classSize; blockStart += globalProjectionBlockSize){
+							const obsIndex* observations = &*classBegin + blockStart;
+							const int blockSize = std::min(globalProjectionBlockSize, classSize-blockStart);
+							projection.project(data, observations, blockSize, projectedValues.data());
+							for(int j = 0; j < blockSize; ++j){
+								zipIterator->setPair(classNum,projectedValues[j],obsWeights[observations[j]]);
+								++zipIterator;
 							}
-							zipIterator->setPair(classNum,accumulator);
-							++zipIterator;
 						}
-
 					}
-
 				}
 
 
 				inline void setClassTotals(){
-					propertiesOfThisNode.setupClassTotals(nodeIndices);
+					propertiesOfThisNode.setupWeightedClassTotals(nodeIndices);
 					bestSplit.setImpurity(propertiesOfThisNode.calcAndReturnImpurity());
 				}
 
 
 				inline void sortWorkingSet(){
-					pdqsort_branchless(zipIters.returnZipBegin(), zipIters.returnZipEnd());
+					const int numItems = zipIters.returnZipEnd() - zipIters.returnZipBegin();
+					switch(context->returnSortStrategy()){
+						case 1:
+							pdqsort_branchless(zipIters.returnZipBegin(), zipIters.returnZipEnd());
+							break;
+						case 2:
+							radixSort(zipIters.returnZipBegin(), zipIters.returnZipEnd(), sortBuffer);
+							break;
+						default:
+							if(numItems < globalInsertionSortMax){
+								pdqsort_detail::insertion_sort(zipIters.returnZipBegin(), zipIters.returnZipEnd(), std::less<zipClassAndValue<int,V> >());
+							}else if(numItems >= globalRadixSortMin && sizeof(typename radixSortKey<V>::type) <= 4){
+								radixSort(zipIters.returnZipBegin(), zipIters.returnZipEnd(), sortBuffer);
+							}else{
+								pdqsort_branchless(zipIters.returnZipBegin(), zipIters.returnZipEnd());
+							}
+					}
+				}
+
+
+				template <typename M>
+				inline void setVecOfSplitLocations(M& fMtry){
+					if(bestProjection >= 0){
+						setVecOfSplitLocationsFromProjection();
+					}else if(summedAreaTables != NULL){
+						setVecOfSplitLocations(returnSummedAreaTableAccessor(), fMtry);
+					}else if(context->dataIsRowMajor()){
+						setVecOfSplitLocations(context->returnRowMajorAccessor<T>(), fMtry);
+					}else{
+						setVecOfSplitLocations(context->returnColMajorAccessor<T>(), fMtry);
+					}
 				}
 
 
-				inline void setVecOfSplitLocations(int fMtry){
+				template <typename A>
+				inline void setVecOfSplitLocations(const A& data, int fMtry){
 
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
-						std::vector<int>::iterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
-						std::vector<int>::iterator  higherValueIndices = nodeIndices.returnEndIterator(i);
-						std::vector<int>::iterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
+					for(int i = 0; i < context->returnNumClasses(); ++i){
+						obsIndexIterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
+						obsIndexIterator  higherValueIndices = nodeIndices.returnEndIterator(i);
+						obsIndexIterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
 
 						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
-							if(fpSingleton::getSingleton().returnFeatureVal(fMtry,*lowerValueIndices) <= bestSplit.returnSplitValue()){
+							if(data.returnFeatureValue(fMtry,*lowerValueIndices) <= bestSplit.returnSplitValue()){
 								std::iter_swap(smallerNumberIndex, lowerValueIndices);
 								++smallerNumberIndex;
 							}
@@ -363,47 +507,39 @@ namespace fp{
 				}
 
 
-				inline void setVecOfSplitLocations(std::vector<int> fMtry){
+				template <typename A>
+				inline void setVecOfSplitLocations(const A& data, std::vector<int>& fMtry){
+					projection.setProjection(fMtry);
+					setVecOfSplitLocationsProjected(data);
+				}
 
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
-						std::vector<int>::iterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
-						std::vector<int>::iterator  higherValueIndices = nodeIndices.returnEndIterator(i);
-						std::vector<int>::iterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
 
-						T aggregator;	
-						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
-							aggregator = 0;
-							for(auto i : fMtry){
-								aggregator += fpSingleton::getSingleton().returnFeatureVal(i,*lowerValueIndices);
-							}
-							if(aggregator <= bestSplit.returnSplitValue()){
-								std::iter_swap(smallerNumberIndex, lowerValueIndices);
-								++smallerNumberIndex;
-							}
-						}
-						nodeIndices.loadSplitIterator(smallerNumberIndex);
-					}
+				template <typename A>
+				inline void setVecOfSplitLocations(const A& data, weightedFeature& fMtry){
+					projection.setProjection(fMtry);
+					setVecOfSplitLocationsProjected(data);
 				}
 
 
-				inline void setVecOfSplitLocations(weightedFeature fMtry){
+				//a block is projected before any of it is swapped; swaps only
+				//move observations that have already been compared.
+				template <typename A>
+				inline void setVecOfSplitLocationsProjected(const A& data){
+					projectedValues.resize(globalProjectionBlockSize);
 
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
-						std::vector<int>::iterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
-						std::vector<int>::iterator  higherValueIndices = nodeIndices.returnEndIterator(i);
-						std::vector<int>::iterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
+					for(int i = 0; i < context->returnNumClasses(); ++i){
+						obsIndexIterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
+						obsIndexIterator  higherValueIndices = nodeIndices.returnEndIterator(i);
+						obsIndexIterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
 
-						T aggregator;	
-						int weightNum;
-						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
-							aggregator = 0;
-							weightNum = 0;
-							for(auto i : fMtry.returnFeatures()){
-								aggregator += fpSingleton::getSingleton().returnFeatureVal(i,*lowerValueIndices)*fMtry.returnWeights()[weightNum++];
-							}
-							if(aggregator <= bestSplit.returnSplitValue()){
-								std::iter_swap(smallerNumberIndex, lowerValueIndices);
-								++smallerNumberIndex;
+						while(lowerValueIndices < higherValueIndices){
+							const int blockSize = std::min<long>(globalProjectionBlockSize, higherValueIndices-lowerValueIndices);
+							projection.project(data, &*lowerValueIndices, blockSize, projectedValues.data());
+							for(int j = 0; j < blockSize; ++j, ++lowerValueIndices){
+								if(projectedValues[j] <= bestSplit.returnSplitValue()){
+									std::iter_swap(smallerNumberIndex, lowerValueIndices);
+									++smallerNumberIndex;
+								}
 							}
 						}
 						nodeIndices.loadSplitIterator(smallerNumberIndex);
@@ -416,21 +552,62 @@ namespace fp{
 				}
 
 
-				inline void setZipIters(zipperIterators<int,T>& zipperIters, int numObjects){
+				inline void setZipIters(zipperIterators<int,V>& zipperIters, int numObjects){
 					zipIters.setZipIterators(zipperIters, numObjects, isLeftNode);
 				}
 
 			public:
 
-				processingNodeBin(int tr, int pN, int d, randomNumberRerFMWC& randNumBin): treeNum(tr), parentNodeNumber(pN), depth(d), propertiesOfThisNode(fpSingleton::getSingleton().returnNumClasses()), propertiesOfLeftNode(fpSingleton::getSingleton().returnNumClasses()),propertiesOfRightNode(fpSingleton::getSingleton().returnNumClasses()),nodeIndices(fpSingleton::getSingleton().returnNumClasses()){
+				processingNodeBin(int tr, int pN, int d, randomNumberRerFMWC& randNumBin, fpContext& forestContext): treeNum(tr), parentNodeNumber(pN), depth(d), propertiesOfThisNode(forestContext.returnNumClasses()), propertiesOfLeftNode(forestContext.returnNumClasses()),propertiesOfRightNode(forestContext.returnNumClasses()),nodeIndices(forestContext.returnNumClasses()){
 					randNum = &randNumBin;	
+					context = &forestContext;
+					projectionCache = NULL;
+					projectionCacheSize = 0;
+					bestProjection = -1;
+					cacheProjections = false;
+					summedAreaTables = NULL;
 				}
 
 
+				inline void setProjectionCache(std::vector<V>& cache){
+					projectionCache = cache.empty() ? NULL : cache.data();
+					projectionCacheSize = cache.size()/2;
+				}
+
+
+				inline void setSummedAreaTables(const T* tables){
+					summedAreaTables = tables;
+				}
+
+
+				inline rowMajorAccessor<T> returnSummedAreaTableAccessor(){
+					return rowMajorAccessor<T>(summedAreaTables, summedAreaTable::returnTableSize(context->returnImageHeight(), context->returnImageWidth()));
+				}
+
+
+				/*
+				 * Readies a node that has been grown for reuse.  Scratch vectors
+				 * keep their capacity so a recycled node does not allocate once
+				 * its buffers have grown, except the radix buffer which is only
+				 * needed by large nodes and is released.
+				 */
+				inline void resetNode(int tr, int pN, int d, randomNumberRerFMWC& randNumBin){
+					treeNum = tr;
+					parentNodeNumber = pN;
+					depth = d;
+					leafNode = false;
+					bestProjection = -1;
+					cacheProjections = false;
+					randNum = &randNumBin;
+					nodeIndices.resetSplitIterators();
+					std::vector<zipClassAndValue<int,V> >().swap(sortBuffer);
+				}
 
 
 
-				inline void setupRoot(obsIndexAndClassVec& indexHolder, typename std::vector<zipClassAndValue<int,T> >& zipper){
+
+
+				inline void setupRoot(obsIndexAndClassVec& indexHolder, typename std::vector<zipClassAndValue<int,V> >& zipper){
 					setRootNodeIndices(indexHolder);
 					setClassTotals();
 					setRootNodeZipIters(zipper);
@@ -441,15 +618,15 @@ namespace fp{
 					setIsLeftNode(leftNode);
 					setNodeIndices(parentNode.nodeIndices);
 					setClassTotals();
-					setZipIters(parentNode.zipIters, propertiesOfThisNode.returnNumItems());
+					setZipIters(parentNode.zipIters, returnNodeSize());
 				}
 
 
-				inline void setupNode(nodeIterators& nodeIts, zipperIterators<int,T>& zips, bool leftNode){
+				inline void setupNode(nodeIterators& nodeIts, zipperIterators<int,V>& zips, bool leftNode){
 					setIsLeftNode(leftNode);
 					setNodeIndices(nodeIts);
 					setClassTotals();
-					setZipIters(zips, propertiesOfThisNode.returnNumItems());
+					setZipIters(zips, returnNodeSize());
 				}
 
 
@@ -457,10 +634,10 @@ namespace fp{
 					if(propertiesOfThisNode.isNodePure()){
 						return true;
 					}
-					if (depth >= fpSingleton::getSingleton().returnMaxDepth()){
+					if (depth >= context->returnMaxDepth()){
 						return true;
 					}
-					return propertiesOfThisNode.isSizeLTMinParent(fpSingleton::getSingleton().returnMinParent());
+					return propertiesOfThisNode.isSizeLTMinParent(context->returnMinParent());
 				}
 
 				inline void setAsLeafNode(){
@@ -493,36 +670,185 @@ namespace fp{
 				inline bool isLeafNode(){
 					return leafNode;
 				}
-				inline void calcBestSplitInfoForNode(Q featureToTry){
+				inline void calcBestSplitInfoForNode(Q& featureToTry){
 					loadWorkingSet(featureToTry);
-					sortWorkingSet();
-					resetRightNode();
-					resetLeftNode();
-					findBestSplit(featureToTry);
+
+					const bool cacheCandidate = cacheProjections;
+					const int candidateProjection = (bestProjection == 0) ? 1 : 0;
+					const double previousImpurity = bestSplit.returnImpurity();
+					if(cacheCandidate){
+						saveProjection(candidateProjection);
+					}
+
+					if(useHistogramSplit()){
+						setHistogramCuts();
+						findBestHistogramSplit(featureToTry);
+					}else{
+						sortWorkingSet();
+						resetRightNode();
+						resetLeftNode();
+						findBestSplit(featureToTry);
+					}
+
+					if(cacheCandidate && bestSplit.returnImpurity() < previousImpurity){
+						bestProjection = candidateProjection;
+					}
 				}
 
 
-				inline void calcBestSplit(){
-					calcMtryForNode(mtry);
-					while(!mtry.empty()){
-						calcBestSplitInfoForNode(mtry.back());
-						removeTriedMtry();
+				/*
+				 * Projection cache.  A projection of several features is gathered
+				 * once to find its split and, if it wins, again to partition the
+				 * node.  Before the working set is sorted each candidate's values
+				 * are saved in node order to the half of the cache not holding
+				 * the best candidate so far, letting the winner partition the
+				 * node without a second gather.  Saving costs a write per
+				 * observation for every candidate, so a node only caches when
+				 * its candidates average globalProjectionCacheMinFeatures
+				 * features.  Candidates evaluated by feature tasks are not
+				 * cached.
+				 */
+				inline int numProjectionFeatures(int){
+					return 1;
+				}
+
+				inline int numProjectionFeatures(std::vector<int>& candidate){
+					return candidate.size();
+				}
+
+				inline int numProjectionFeatures(weightedFeature& candidate){
+					return candidate.returnFeatures().size();
+				}
+
+				inline bool cacheProjection(){
+					if(projectionCache == NULL || std::is_same<Q,int>::value || mtry.empty() || useFeatureTasks()){
+						return false;
 					}
+					int totalFeatures = 0;
+					for(auto& candidate : mtry){
+						totalFeatures += numProjectionFeatures(candidate);
+					}
+					return totalFeatures >= globalProjectionCacheMinFeatures*(int)mtry.size();
 				}
 
-				inline void removeTriedMtry(){
-					if(bestSplit.perfectSplitFound()){
-						mtry.clear();
-					}else{
-						mtry.pop_back();
+
+				inline V* returnProjection(int half){
+					return projectionCache + (size_t)half*projectionCacheSize + zipIters.returnZipOffset();
+				}
+
+
+				inline void saveProjection(int half){
+					V* projection = returnProjection(half);
+					for(typename std::vector<zipClassAndValue<int,V> >::iterator zipIterator = zipIters.returnZipBegin(); zipIterator != zipIters.returnZipEnd(); ++zipIterator){
+						*projection++ = zipIterator->returnFeatureVal();
+					}
+				}
+
+
+				inline void setVecOfSplitLocationsFromProjection(){
+					const V* projection = returnProjection(bestProjection);
+					for(int i = 0; i < context->returnNumClasses(); ++i){
+						obsIndexIterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
+						obsIndexIterator  higherValueIndices = nodeIndices.returnEndIterator(i);
+						obsIndexIterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
+
+						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
+							if(*projection++ <= bestSplit.returnSplitValue()){
+								std::iter_swap(smallerNumberIndex, lowerValueIndices);
+								++smallerNumberIndex;
+							}
+						}
+						nodeIndices.loadSplitIterator(smallerNumberIndex);
+					}
+				}
+
+
+				/*
+				 * Feature tasks.  With useFeatureTasks the candidates of a node
+				 * with at least globalFeatureTaskMin observations are split
+				 * between up to numCores tasks.  Each task works on a copy of the
+				 * node with its own working set and keeps the best split of every
+				 * candidate it tries.  The reduction walks the candidates in the
+				 * order the serial loop tries them (last first) and keeps the
+				 * first strictly better split, so ties go to the highest index
+				 * and the split chosen is the one the serial loop would choose.
+				 * In histogram mode candidates draw from generators seeded up
+				 * front so the cuts do not depend on which task tried them.
+				 */
+				inline bool useFeatureTasks(){
+					return context->returnUseFeatureTasks() && mtry.size() > 1 && returnNodeSize() >= globalFeatureTaskMin;
+				}
+
+
+				inline void calcCandidateSplits(const int firstCandidate, const int stride, std::vector<int>& candidateSeeds, std::vector<bestSplitInfo<V, Q> >& candidateSplits){
+					processingNodeBin worker(*this);
+					std::vector<zipClassAndValue<int,V> > workerZipper(returnNodeSize());
+					worker.zipIters.setZipIteratorsRoot(workerZipper);
+					randomNumberRerFMWC workerRandNum;
+					worker.randNum = &workerRandNum;
+
+					for(int candidate = firstCandidate; candidate < (int)mtry.size(); candidate += stride){
+						workerRandNum.initialize(candidateSeeds[candidate]);
+						worker.bestSplit = bestSplit;
+						worker.calcBestSplitInfoForNode(mtry[candidate]);
+						candidateSplits[candidate] = worker.bestSplit;
+					}
+				}
+
+
+				inline void calcBestSplitWithTasks(){
+					const int numCandidates = mtry.size();
+					const int numTasks = std::min(numCandidates, context->returnNumThreads());
+
+					//only histogram cuts draw random numbers while a candidate is
+					//tried, leave the node's generator alone otherwise.
+					std::vector<int> candidateSeeds(numCandidates, 0);
+					if(context->returnNumHistogramBins()){
+						for(auto& seed : candidateSeeds){
+							seed = randNum->gen(std::numeric_limits<int>::max());
+						}
+					}
+					std::vector<bestSplitInfo<V, Q> > candidateSplits(numCandidates);
+
+					for(int taskNum = 0; taskNum < numTasks; ++taskNum){
+#pragma omp task shared(candidateSeeds, candidateSplits) firstprivate(taskNum)
+						calcCandidateSplits(taskNum, numTasks, candidateSeeds, candidateSplits);
+					}
+#pragma omp taskwait
+
+					for(int candidate = numCandidates-1; candidate >= 0; --candidate){
+						if(candidateSplits[candidate].returnImpurity() < bestSplit.returnImpurity()){
+							bestSplit = candidateSplits[candidate];
+						}
+					}
+				}
+
+
+				inline void calcBestSplit(){
+					bestProjection = -1;
+					calcMtryForNode(mtry);
+					cacheProjections = cacheProjection();
+					if(useFeatureTasks()){
+						calcBestSplitWithTasks();
+						return;
+					}
+					//candidates are tried last to first and left in place so
+					//their storage is reused by the next node.
+					for(int candidate = (int)mtry.size()-1; candidate >= 0; --candidate){
+						calcBestSplitInfoForNode(mtry[candidate]);
+						if(bestSplit.perfectSplitFound()){
+							break;
+						}
 					}
 				}
 
+				//number of distinct observations in the node, the size of its
+				//working set.  Class totals count observations by weight.
 				inline int returnNodeSize(){
-					return propertiesOfThisNode.returnNumItems();
+					return nodeIndices.returnNumEntries();
 				}
 
-				inline T returnNodeCutValue(){
+				inline V returnNodeCutValue(){
 					return bestSplit.returnSplitValue();
 				}
 
@@ -550,12 +876,12 @@ namespace fp{
 					return nodeIndices;
 				}
 
-				inline zipperIterators<int,T>& returnZipIterators(){
+				inline zipperIterators<int,V>& returnZipIterators(){
 					return zipIters;
 				}
 
 				inline bool isLeftChildLarger(){
-					return nodeIndices.returnLeftChildSize() > propertiesOfThisNode.returnNumItems() - nodeIndices.returnLeftChildSize();
+					return nodeIndices.returnLeftChildSize() > returnNodeSize() - nodeIndices.returnLeftChildSize();
 				}
 
 				inline int returnNodeClass(){
@@ -577,7 +903,7 @@ namespace fp{
 					return mtry;
 				}
 
-				inline bestSplitInfo<T, Q>& exposeBestSplit(){
+				inline bestSplitInfo<V, Q>& exposeBestSplit(){
 					return bestSplit;
 				}
 
@@ -597,7 +923,7 @@ namespace fp{
 					return nodeIndices;
 				}
 
-				inline zipperIterators<int,T>& exposeZipIters(){
+				inline zipperIterators<int,V>& exposeZipIters(){
 					return zipIters;
 				}
 
@@ -0,0 +1,84 @@
+#ifndef sparseProjection_h
+#define sparseProjection_h
+
+#include <vector>
+#include "obsIndexAndClassVec.h"
+#include "../../baseFunctions/weightedFeature.h"
+#include "../../fpSingleton/dataset/dataAccessors.h"
+
+namespace fp{
+
+	/*
+	 * A candidate projection split by sign.  RerF and ternary projections
+	 * only weight features by +1 or -1, so they are summed with adds and
+	 * subtracts; any other weight is kept with its feature and multiplied.
+	 * project() fills the values of a block of observations a feature at a
+	 * time, so column major data is read as one gather per feature, which
+	 * the compiler can vectorize, and a block of rows stays in cache across
+	 * features.  Every load and partition of a projection goes through here
+	 * so the values compared against a split are summed in the same order.
+	 */
+	template<typename V>
+		class sparseProjection
+		{
+			protected:
+				std::vector<int> addedFeatures;
+				std::vector<int> subtractedFeatures;
+				std::vector<int> weightedFeatures;
+				std::vector<V> featureWeights;
+
+				inline void clearProjection(){
+					addedFeatures.clear();
+					subtractedFeatures.clear();
+					weightedFeatures.clear();
+					featureWeights.clear();
+				}
+
+			public:
+				inline void setProjection(const std::vector<int>& features){
+					clearProjection();
+					addedFeatures = features;
+				}
+
+				inline void setProjection(weightedFeature& features){
+					clearProjection();
+					for(int i = 0; i < (int)features.returnFeatures().size(); ++i){
+						const float weight = features.returnWeights()[i];
+						if(weight == 1){
+							addedFeatures.push_back(features.returnFeatures()[i]);
+						}else if(weight == -1){
+							subtractedFeatures.push_back(features.returnFeatures()[i]);
+						}else{
+							weightedFeatures.push_back(features.returnFeatures()[i]);
+							featureWeights.push_back((V)weight);
+						}
+					}
+				}
+
+
+				template<typename A>
+					inline void project(const A& data, const obsIndex* observations, const int numObservations, V* values) const{
+						for(int j = 0; j < numObservations; ++j){
+							values[j] = 0;
+						}
+						for(auto feature : addedFeatures){
+							for(int j = 0; j < numObservations; ++j){
+								values[j] += data.returnFeatureValue(feature, observations[j]);
+							}
+						}
+						for(auto feature : subtractedFeatures){
+							for(int j = 0; j < numObservations; ++j){
+								values[j] -= data.returnFeatureValue(feature, observations[j]);
+							}
+						}
+						for(int i = 0; i < (int)weightedFeatures.size(); ++i){
+							const V weight = featureWeights[i];
+							for(int j = 0; j < numObservations; ++j){
+								values[j] += data.returnFeatureValue(weightedFeatures[i], observations[j])*weight;
+							}
+						}
+					}
+		};
+
+}//namespace fp
+#endif //sparseProjection_h
@@ -0,0 +1,61 @@
+#ifndef summedAreaTable_h
+#define summedAreaTable_h
+
+#include "../../baseFunctions/weightedFeature.h"
+
+namespace fp{
+
+	/*
+	 * Summed area tables for structured RerF.  The table of an image has a
+	 * row and a column of zeros ahead of the image so entry (r,c) is the sum
+	 * of every pixel above and left of pixel (r,c).  The sum of any patch is
+	 * then two table entries added and two subtracted, however large the
+	 * patch, so a patch is stored as a weightedFeature of those four table
+	 * indices and projected like any other ternary feature.
+	 */
+	class summedAreaTable
+	{
+		public:
+			static inline int returnTableSize(const int imageHeight, const int imageWidth){
+				return (imageHeight+1)*(imageWidth+1);
+			}
+
+
+			//pixel(i) returns pixel i of the image in row major order.
+			template<typename T, typename F>
+				static inline void buildTable(const F& pixel, const int imageHeight, const int imageWidth, T* table){
+					const int tableWidth = imageWidth+1;
+					for(int col = 0; col < tableWidth; ++col){
+						table[col] = 0;
+					}
+					for(int row = 0; row < imageHeight; ++row){
+						T* previousRow = table + row*tableWidth;
+						T* currentRow = previousRow + tableWidth;
+						T rowSum = 0;
+						currentRow[0] = 0;
+						for(int col = 0; col < imageWidth; ++col){
+							rowSum += pixel(row*imageWidth + col);
+							currentRow[col+1] = previousRow[col+1] + rowSum;
+						}
+					}
+				}
+
+
+			static inline void setPatch(weightedFeature& feature, const int topLeftPixel, const int patchHeight, const int patchWidth, const int imageWidth){
+				const int tableWidth = imageWidth+1;
+				const int upperLeft = (topLeftPixel/imageWidth)*tableWidth + topLeftPixel%imageWidth;
+				const int lowerLeft = upperLeft + patchHeight*tableWidth;
+
+				feature.returnFeatures().push_back(lowerLeft + patchWidth);
+				feature.returnWeights().push_back(1);
+				feature.returnFeatures().push_back(upperLeft);
+				feature.returnWeights().push_back(1);
+				feature.returnFeatures().push_back(upperLeft + patchWidth);
+				feature.returnWeights().push_back(-1);
+				feature.returnFeatures().push_back(lowerLeft);
+				feature.returnWeights().push_back(-1);
+			}
+	};
+
+}//namespace fp
+#endif //summedAreaTable_h
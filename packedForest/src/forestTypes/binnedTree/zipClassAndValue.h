@@ -7,13 +7,22 @@
 
 namespace fp{
 
+	/*
+	 * One record of a node's working set.  Records are not padded so a
+	 * float value and its class fit in eight bytes, which is what the sort
+	 * and split scans stream through.  The record's weight, the number of
+	 * times its observation is in the sample, is kept in the bits of
+	 * classOfObs above the class.
+	 */
 	template<typename T, typename Q>
-		class alignas(16) zipClassAndValue
+		class zipClassAndValue
 		{
 			protected:
 				Q featureVal;
 				T classOfObs;
 
+				static const int weightShift = 16;
+
 			public:
 
 				inline bool operator < (const zipClassAndValue<T,Q>& otherData) const
@@ -22,14 +31,18 @@ namespace fp{
 				}
 
 				inline T returnObsClass(){
-					return classOfObs;
+					return classOfObs & ((1 << weightShift) - 1);
+				}
+
+				inline int returnObsWeight(){
+					return classOfObs >> weightShift;
 				}
 
 				inline Q returnFeatureVal(){
 					return featureVal;
 				}
 
-				inline Q midVal (const zipClassAndValue<T,Q>& otherData) const
+				inline Q midVal(const zipClassAndValue<int,double>& otherData) const
 				{
 					assert(featureVal != otherData.featureVal);
 					assert(featureVal != (featureVal +otherData.featureVal )/2.0);
@@ -37,6 +50,22 @@ namespace fp{
 					return (featureVal + otherData.featureVal)/2.0;
 				}
 
+				inline Q midVal(const zipClassAndValue<int,float>& otherData) const
+				{
+					assert(featureVal != otherData.featureVal);
+					assert(featureVal != (featureVal +otherData.featureVal )/2.0);
+					assert(otherData.featureVal != (featureVal+otherData.featureVal)/2.0);
+					return (featureVal + otherData.featureVal)/2.0;
+				}
+
+				//integer values split on the floor of the mean so x <= mid
+				//separates the two values for negative sums as well.
+				inline Q midVal(const zipClassAndValue<int,int>& otherData) const
+				{
+					assert(featureVal < otherData.featureVal);
+					return (Q)std::floor((featureVal + otherData.featureVal)/2.0);
+				}
+
 				inline bool checkInequality(const zipClassAndValue<int,double>& otherData){
 					return std::abs(featureVal - otherData.featureVal) > std::numeric_limits<double>::epsilon() * 4 * std::abs(featureVal + otherData.featureVal);
 				}
@@ -50,7 +79,13 @@ namespace fp{
 				}
 
 				void setPair(T obsClass, Q val){
-					classOfObs = obsClass;
+					setPair(obsClass, val, 1);
+				}
+
+				void setPair(T obsClass, Q val, int weight){
+					assert(obsClass >= 0 && obsClass < (1 << weightShift));
+					assert(weight > 0 && weight < (1 << (31 - weightShift)));
+					classOfObs = obsClass | (weight << weightShift);
 					featureVal = val;
 				}
 		};
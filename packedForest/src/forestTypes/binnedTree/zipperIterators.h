@@ -12,6 +12,8 @@ namespace fp{
 			protected:
 				typename std::vector<zipClassAndValue<T,Q> >::iterator zipBegin;
 				typename std::vector<zipClassAndValue<T,Q> >::iterator zipEnd;
+				//start of the whole zipper, locates the node in other per-observation scratch.
+				typename std::vector<zipClassAndValue<T,Q> >::iterator zipRoot;
 
 			public:
 				zipperIterators(){ }
@@ -32,12 +34,23 @@ namespace fp{
 					return zipEnd;
 				}
 
+				inline int returnZipOffset(){
+					return zipBegin - zipRoot;
+				}
+
 				inline void setZipIteratorsRoot(typename std::vector<zipClassAndValue<T,Q> >& zipper){
+					zipRoot = zipper.begin();
 					zipBegin = zipper.begin();
 					zipEnd = zipper.end();
 				}
 
+				inline void setZipIteratorsRoot(typename std::vector<zipClassAndValue<T,Q> >& zipper, int numObjects){
+					setZipIteratorsRoot(zipper);
+					zipEnd = zipBegin+numObjects;
+				}
+
 				inline void setZipIterators(zipperIterators<int,Q>& zipperIters, int numObjects, bool isLeftNode){
+					zipRoot = zipperIters.zipRoot;
 					if(isLeftNode){
 						zipBegin = zipperIters.zipBegin;
 						zipEnd = zipBegin+numObjects;
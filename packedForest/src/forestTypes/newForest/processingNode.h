@@ -8,7 +8,7 @@
 #include "nodeIterators.h"
 #include "zipperIterators.h"
 #include <assert.h>
-#include "../../fpSingleton/fpSingleton.h"
+#include "../../fpSingleton/fpContext.h"
 #include "../../baseFunctions/pdqsort.h"
 
 
@@ -23,6 +23,7 @@ namespace fp{
 	template<typename T, typename Q>
 		class processingNode{
 			protected:
+				fpContext* context;
 				int treeNum;
 				int parentNodeNumber;
 				int nodeNumber;
@@ -44,7 +45,7 @@ namespace fp{
 
 				/*
 					 inline void calcMtryForNode(std::vector<int>& featuresToTry){
-					 for (int i=0; i<fpSingleton::getSingleton().returnNumFeatures(); ++i){
+					 for (int i=0; i<context->returnNumFeatures(); ++i){
 					 featuresToTry.push_back(i);
 					 }
 
@@ -53,8 +54,8 @@ namespace fp{
 
 					 int tempSwap;
 
-					 for(int locationToMove = 0; locationToMove < fpSingleton::getSingleton().returnMtry(); locationToMove++){
-					 std::uniform_int_distribution<> distr(locationToMove, fpSingleton::getSingleton().returnNumFeatures()-1);
+					 for(int locationToMove = 0; locationToMove < context->returnMtry(); locationToMove++){
+					 std::uniform_int_distribution<> distr(locationToMove, context->returnNumFeatures()-1);
 					 int randomPosition = distr(eng);
 
 					 tempSwap = featuresToTry[locationToMove];
@@ -62,48 +63,48 @@ namespace fp{
 					 featuresToTry[randomPosition] = tempSwap;
 					 }
 
-					 featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					 featuresToTry.resize(context->returnMtry());
 					 }
 					 */
 
 				inline void calcMtryForNode(std::vector<int>& featuresToTry){
-					for (int i=0; i<fpSingleton::getSingleton().returnNumFeatures(); ++i){
+					for (int i=0; i<context->returnNumFeatures(); ++i){
 						featuresToTry.push_back(i);
 					}
 
 					int tempSwap;
 
-					for(int locationToMove = 0; locationToMove < fpSingleton::getSingleton().returnMtry(); locationToMove++){
-						int randomPosition = fpSingleton::getSingleton().genRandom(fpSingleton::getSingleton().returnNumFeatures()-locationToMove)+locationToMove;
+					for(int locationToMove = 0; locationToMove < context->returnMtry(); locationToMove++){
+						int randomPosition = context->genRandom(context->returnNumFeatures()-locationToMove)+locationToMove;
 						tempSwap = featuresToTry[locationToMove];
 						featuresToTry[locationToMove] = featuresToTry[randomPosition];
 						featuresToTry[randomPosition] = tempSwap;
 					}
 
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					featuresToTry.resize(context->returnMtry());
 				}
 
 
 
 				inline void calcMtryForNode(std::vector<std::vector<int> >& featuresToTry){
-					featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					featuresToTry.resize(context->returnMtry());
 					int rndMtry;
 					int rndFeature;
-					for (int i=0; i < fpSingleton::getSingleton().returnMtry(); ++i){
-						rndMtry = fpSingleton::getSingleton().genRandom(fpSingleton::getSingleton().returnMtry());
-						rndFeature = fpSingleton::getSingleton().genRandom(fpSingleton::getSingleton().returnNumFeatures());
+					for (int i=0; i < context->returnMtry(); ++i){
+						rndMtry = context->genRandom(context->returnMtry());
+						rndFeature = context->genRandom(context->returnNumFeatures());
 						featuresToTry[rndMtry].push_back(rndFeature);
 					}
 				}
 
 				/*
 					 inline void calcMtryForNode(std::vector<std::vector<int> >& featuresToTry){
-					 featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+					 featuresToTry.resize(context->returnMtry());
 					 int rndMtry;
 					 int rndFeature;
-					 for (int i=0; i < fpSingleton::getSingleton().returnMtry(); ++i){
-					 rndMtry = std::rand() % fpSingleton::getSingleton().returnMtry();
-					 rndFeature = std::rand() % fpSingleton::getSingleton().returnNumFeatures();
+					 for (int i=0; i < context->returnMtry(); ++i){
+					 rndMtry = std::rand() % context->returnMtry();
+					 rndFeature = std::rand() % context->returnNumFeatures();
 					 featuresToTry[rndMtry].push_back(rndFeature);
 					 }
 					 }
@@ -155,15 +156,15 @@ namespace fp{
 
 				inline void loadWorkingSet(int currMTRY){
 					typename std::vector<zipClassAndValue<int,T> >::iterator zipIterator = zipIters.returnZipBegin();
-					for(int classNum = 0; classNum < fpSingleton::getSingleton().returnNumClasses(); ++classNum){
+					for(int classNum = 0; classNum < context->returnNumClasses(); ++classNum){
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
-							//fpSingleton::getSingleton().prefetchFeatureVal(currMTRY,*q);
+						for(obsIndexIterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
+							//context->prefetchFeatureVal<T>(currMTRY,*q);
 						}
 
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
-							zipIterator->setPair(classNum, fpSingleton::getSingleton().returnFeatureVal(currMTRY,*q));
+						for(obsIndexIterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
+							zipIterator->setPair(classNum, context->returnFeatureVal<T>(currMTRY,*q));
 							++zipIterator;
 						}
 					}	
@@ -176,18 +177,18 @@ namespace fp{
 					typename std::vector<zipClassAndValue<int,T> >::iterator zipIterator = zipIters.returnZipBegin();
 					T accumulator;
 
-					for(int classNum = 0; classNum < fpSingleton::getSingleton().returnNumClasses(); ++classNum){
+					for(int classNum = 0; classNum < context->returnNumClasses(); ++classNum){
 
 						/*
-							 for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
-						//fpSingleton::getSingleton().prefetchFeatureVal(currMTRY,*q);
+							 for(obsIndexIterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
+						//context->prefetchFeatureVal<T>(currMTRY,*q);
 						}
 						*/
 
-						for(std::vector<int>::iterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
+						for(obsIndexIterator q=nodeIndices.returnBeginIterator(classNum); q!=nodeIndices.returnEndIterator(classNum); ++q){
 							accumulator=0;
 							for(auto i : currMTRY){
-								accumulator+=	fpSingleton::getSingleton().returnFeatureVal(i,*q);
+								accumulator+=	context->returnFeatureVal<T>(i,*q);
 							}
 							zipIterator->setPair(classNum,accumulator);
 							++zipIterator;
@@ -212,13 +213,13 @@ namespace fp{
 
 				inline void setVecOfSplitLocations(int fMtry){
 
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
-						std::vector<int>::iterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
-						std::vector<int>::iterator  higherValueIndices = nodeIndices.returnEndIterator(i);
-						std::vector<int>::iterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
+					for(int i = 0; i < context->returnNumClasses(); ++i){
+						obsIndexIterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
+						obsIndexIterator  higherValueIndices = nodeIndices.returnEndIterator(i);
+						obsIndexIterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
 
 						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
-							if(fpSingleton::getSingleton().returnFeatureVal(fMtry,*lowerValueIndices) <= bestSplit.returnSplitValue()){
+							if(context->returnFeatureVal<T>(fMtry,*lowerValueIndices) <= bestSplit.returnSplitValue()){
 								std::iter_swap(smallerNumberIndex, lowerValueIndices);
 								++smallerNumberIndex;
 							}
@@ -230,16 +231,16 @@ namespace fp{
 
 				inline void setVecOfSplitLocations(std::vector<int> fMtry){
 
-					for(int i = 0; i < fpSingleton::getSingleton().returnNumClasses(); ++i){
-						std::vector<int>::iterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
-						std::vector<int>::iterator  higherValueIndices = nodeIndices.returnEndIterator(i);
-						std::vector<int>::iterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
+					for(int i = 0; i < context->returnNumClasses(); ++i){
+						obsIndexIterator  lowerValueIndices = nodeIndices.returnBeginIterator(i);
+						obsIndexIterator  higherValueIndices = nodeIndices.returnEndIterator(i);
+						obsIndexIterator  smallerNumberIndex = nodeIndices.returnBeginIterator(i);
 
 						T aggregator;	
 						for(; lowerValueIndices < higherValueIndices; ++lowerValueIndices){
 							aggregator = 0;
 							for(auto i : fMtry){
-								aggregator += fpSingleton::getSingleton().returnFeatureVal(i,*lowerValueIndices);
+								aggregator += context->returnFeatureVal<T>(i,*lowerValueIndices);
 							}
 							if(aggregator <= bestSplit.returnSplitValue()){
 								std::iter_swap(smallerNumberIndex, lowerValueIndices);
@@ -262,7 +263,7 @@ namespace fp{
 
 			public:
 
-				processingNode(int tr, int pN): treeNum(tr), parentNodeNumber(pN),propertiesOfThisNode(fpSingleton::getSingleton().returnNumClasses()), propertiesOfLeftNode(fpSingleton::getSingleton().returnNumClasses()),propertiesOfRightNode(fpSingleton::getSingleton().returnNumClasses()),nodeIndices(fpSingleton::getSingleton().returnNumClasses()){}
+				processingNode(int tr, int pN, fpContext& forestContext): context(&forestContext), treeNum(tr), parentNodeNumber(pN),propertiesOfThisNode(forestContext.returnNumClasses()), propertiesOfLeftNode(forestContext.returnNumClasses()),propertiesOfRightNode(forestContext.returnNumClasses()),nodeIndices(forestContext.returnNumClasses()){}
 
 
 
@@ -295,7 +296,7 @@ namespace fp{
 					if(propertiesOfThisNode.isNodePure()){
 						return true;
 					}
-					return propertiesOfThisNode.isSizeLTMinParent(fpSingleton::getSingleton().returnMinParent());
+					return propertiesOfThisNode.isSizeLTMinParent(context->returnMinParent());
 				}
 
 				inline void setAsLeafNode(){
@@ -9,6 +9,7 @@ namespace fp{
 	template <typename T> //
 		class baseUnprocessedNodeUnsupervised{
 			protected:
+				fpContext* context;
 				int parentID;
 				int depth;
 				double nodeImpurity; //lower impurity is better
@@ -22,11 +23,11 @@ namespace fp{
 				std::vector<T> featureHolder;
 				
 			public:
-				baseUnprocessedNodeUnsupervised(int numObsForRoot):  parentID(0), depth(0), isLeftNode(true){
-					obsIndices = new stratifiedInNodeClassIndicesUnsupervised(numObsForRoot);
+				baseUnprocessedNodeUnsupervised(fpContext& forestContext, int numObsForRoot): context(&forestContext), parentID(0), depth(0), isLeftNode(true){
+					obsIndices = new stratifiedInNodeClassIndicesUnsupervised(forestContext, numObsForRoot);
 				}
 
-				baseUnprocessedNodeUnsupervised(int parentID, int dep, bool isLeft): parentID(parentID), depth(dep), isLeftNode(isLeft){}
+				baseUnprocessedNodeUnsupervised(fpContext& forestContext, int parentID, int dep, bool isLeft): context(&forestContext), parentID(parentID), depth(dep), isLeftNode(isLeft){}
 
 				virtual ~baseUnprocessedNodeUnsupervised(){}
 				
@@ -6,12 +6,14 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include "../../fpSingleton/fpContext.h"
 
 namespace fp{
 
 	class stratifiedInNodeClassIndicesUnsupervised
 	{
 		private:
+			fpContext* context;
 			std::vector<std::vector<int> > inSamples;
 			std::vector<int> inSamps;
 			std::vector<int> outSamps;
@@ -23,10 +25,10 @@ namespace fp{
 
 			//TODO: the following functions would benefit from Vitter's Sequential Random Sampling
 		public:
-			stratifiedInNodeClassIndicesUnsupervised(): inSampleSize(0), outSampleSize(0){}
+			stratifiedInNodeClassIndicesUnsupervised(fpContext& forestContext): context(&forestContext), inSampleSize(0), outSampleSize(0){}
 
 
-			stratifiedInNodeClassIndicesUnsupervised(const int &numObservationsInDataSet): inSampleSize(0), outSampleSize(0){
+			stratifiedInNodeClassIndicesUnsupervised(fpContext& forestContext, const int &numObservationsInDataSet): context(&forestContext), inSampleSize(0), outSampleSize(0){
 				impurity = 10; //initialize to an arbitrary non zero value
 				createInAndOutSetsBagging(numObservationsInDataSet, 0);
 				inSampleSize = inSamps.size();
@@ -51,7 +53,7 @@ namespace fp{
 				int tempMoveObs;
 				for(int n=0; n<numObs; n++){
 					randomObsID = distr(eng);
-					inSamples[fpSingleton::getSingleton().returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[randomObsID]);
+					inSamples[context->returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[randomObsID]);
 					inSamps.push_back(potentialSamples[randomObsID]);
 					if(randomObsID < numUnusedObs){
 						--numUnusedObs;
@@ -62,7 +64,7 @@ namespace fp{
 				}
 
 				for(int n=0; n<numUnusedObs; ++n){
-					outSamples[fpSingleton::getSingleton().returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[n]);
+					outSamples[context->returnLabel(potentialSamples[randomObsID])].push_back(potentialSamples[n]);
 					outSamps.push_back(potentialSamples[n]);
 					}
 				
@@ -168,11 +170,11 @@ namespace fp{
 			}
 
 			inline int returnBinSize(){
-				return fpSingleton::getSingleton().returnBinSize();
+				return context->returnBinSize();
 			}
 
 			inline bool useBin(){
-				return fpSingleton::getSingleton().returnUseBinning() && (inSampleSize > returnBinSize());
+				return context->returnUseBinning() && (inSampleSize > returnBinSize());
 			}
 
 			inline void initializeBinnedSamples(){
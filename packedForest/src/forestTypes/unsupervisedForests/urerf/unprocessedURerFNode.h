@@ -20,15 +20,15 @@ namespace fp{
 				//std::random_device rd;
 				//The next three should be static
 				//std::mt19937 rng(rd());   
-				//std::uniform_int_distribution<int> randomMtry(0,fpSingleton::getSingleton().returnMtry()-1);
-				//std::uniform_int_distribution<int> randomFeature(0,fpSingleton::getSingleton().returnNumFeatures()-1);
+				//std::uniform_int_distribution<int> randomMtry(0,this->context->returnMtry()-1);
+				//std::uniform_int_distribution<int> randomFeature(0,this->context->returnNumFeatures()-1);
 				//Example: auto random_integer = uni(rng);
 
 			public:
-				unprocessedURerFNode(int numObsForRoot): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(numObsForRoot), featuresToTry(fpSingleton::getSingleton().returnMtry()){}
+				unprocessedURerFNode(fpContext& forestContext, int numObsForRoot): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(forestContext, numObsForRoot), featuresToTry(forestContext.returnMtry()){}
 
 
-				unprocessedURerFNode(int parentID, int dep, bool isLeft): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(parentID, dep, isLeft), featuresToTry(fpSingleton::getSingleton().returnMtry()){}
+				unprocessedURerFNode(fpContext& forestContext, int parentID, int dep, bool isLeft): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(forestContext, parentID, dep, isLeft), featuresToTry(forestContext.returnMtry()){}
 
 
 				~unprocessedURerFNode(){}
@@ -59,9 +59,9 @@ namespace fp{
 				inline void pickMTRY(){
 					int rndMtry;
 					int rndFeature;
-					for (int i=0; i < fpSingleton::getSingleton().returnMtry(); ++i){
-						rndMtry = std::rand() % fpSingleton::getSingleton().returnMtry();
-						rndFeature = std::rand() % fpSingleton::getSingleton().returnNumFeatures();
+					for (int i=0; i < this->context->returnMtry(); ++i){
+						rndMtry = std::rand() % this->context->returnMtry();
+						rndFeature = std::rand() % this->context->returnNumFeatures();
 						featuresToTry[rndMtry].push_back(rndFeature);
 					}
 				}
@@ -69,39 +69,39 @@ namespace fp{
 				inline void loadFeatureHolder(){
 					if(baseUnprocessedNodeUnsupervised<T>::obsIndices->useBin()){
 						for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); ++i){
-							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
+							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
 						}
 						if(featuresToTry.back().size()>1){
 							for(unsigned int j =1; j < featuresToTry.back().size(); ++j){
 								for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); q++){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
+									this->context->template prefetchFeatureVal<T>(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
 								}
 								for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); ++i){
-									baseUnprocessedNodeUnsupervised<T>::featureHolder[i] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
+									baseUnprocessedNodeUnsupervised<T>::featureHolder[i] += this->context->template returnFeatureVal<T>(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
 								}
 							}
 						}
 					}else{
 
 						for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); ++i){
-							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
+							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back()[0],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
 						}
 						if(featuresToTry.back().size()>1){
 							for(int j =1; j < (int)featuresToTry.back().size(); ++j){
 								for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); q++){
-									fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
+									this->context->template prefetchFeatureVal<T>(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
 								}
 
 								for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); ++i){
-									baseUnprocessedNodeUnsupervised<T>::featureHolder[i] += fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
+									baseUnprocessedNodeUnsupervised<T>::featureHolder[i] += this->context->template returnFeatureVal<T>(featuresToTry.back()[j],baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
 								}
 							}
 						}
@@ -119,7 +119,7 @@ namespace fp{
 					T featureVal = 0;
 
 					for(auto j : bestSplitInfo.returnFeatureNum()){
-						featureVal += fpSingleton::getSingleton().returnFeatureVal(j,index);
+						featureVal += this->context->template returnFeatureVal<T>(j,index);
 					}
 					if(featureVal <= bestSplitInfo.returnSplitValue()){
 						return true;
@@ -135,8 +135,8 @@ namespace fp{
 
 				inline void moveDataLeftOrRight(){
 
-					baseUnprocessedNodeUnsupervised<T>::leftIndices = new stratifiedInNodeClassIndicesUnsupervised();
-					baseUnprocessedNodeUnsupervised<T>::rightIndices = new stratifiedInNodeClassIndicesUnsupervised();
+					baseUnprocessedNodeUnsupervised<T>::leftIndices = new stratifiedInNodeClassIndicesUnsupervised(*this->context);
+					baseUnprocessedNodeUnsupervised<T>::rightIndices = new stratifiedInNodeClassIndicesUnsupervised(*this->context);
 
 					int lNum =0;
 					int rNum =0;
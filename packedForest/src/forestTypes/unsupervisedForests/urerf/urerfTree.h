@@ -13,6 +13,7 @@ namespace fp{
 		class urerfTree
 		{
 			protected:
+				fpContext* context;
 				float OOBAccuracy;
 				float totalOOB;
 				std::vector<std::vector<int> > indexAndVote;
@@ -21,18 +22,18 @@ namespace fp{
 				std::vector< unprocessedURerFNode<T> > leafNodes;
 
 			public:
-				urerfTree() : totalOOB(0){}
+				urerfTree(fpContext& forestContext) : context(&forestContext), totalOOB(0){}
 
 				void loadFirstNode(){
-					nodeQueue.emplace_back(fpSingleton::getSingleton().returnNumObservations());
+					nodeQueue.emplace_back(*context, context->returnNumObservations());
 				}
 
 				inline bool shouldProcessNode(){
                                         if(nodeQueue.back().returnNodeImpurity() < std::numeric_limits<T>::epsilon())
                                                 return false;
-                                        if(nodeQueue.back().returnInSampleSize() <= fpSingleton::getSingleton().returnMinParent())
+                                        if(nodeQueue.back().returnInSampleSize() <= context->returnMinParent())
                                                 return false;
-                                        if(nodeQueue.back().returnDepth() >= fpSingleton::getSingleton().returnMaxDepth())
+                                        if(nodeQueue.back().returnDepth() >= context->returnMaxDepth())
                                                 return false;
                                         return true;
 				}
@@ -196,10 +197,10 @@ namespace fp{
 
 					nodeQueue.pop_back();
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isLeftNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isLeftNode());
 					nodeQueue.back().loadIndices(leftIndices);
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isRightNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isRightNode());
 					nodeQueue.back().loadIndices(rightIndices);
 				}
 
@@ -23,6 +23,7 @@ namespace fp {
 		class fpURFBase : public fpForestBase<T>
 	{
 		protected:
+			fpContext* context;
 			std::vector<urfTree<T> > trees;
 			std::map<int, std::map<int, int> > simMat;
 			std::map<std::pair<int, int>, double> pairMat;	
@@ -32,6 +33,7 @@ namespace fp {
 			SpMat eigenMat;
 		public:
 
+			fpURFBase(fpContext& forestContext) : context(&forestContext){}
 			~fpURFBase(){}
 
 			fpDisplayProgress printProgress;
@@ -40,18 +42,18 @@ namespace fp {
 			}
 
 			inline void changeForestSize(){
-				trees.resize(fpSingleton::getSingleton().returnNumTrees());
+				trees.resize(context->returnNumTrees(), urfTree<T>(*context));
 			}
 
 			inline void initSimMat(){
-				auto numObs = fpSingleton::getSingleton().returnNumObservations();
+				auto numObs = context->returnNumObservations();
 				for(auto i = 0; i < numObs; ++i) {
 					std::map<int, int> init_map;
 					simMat[i] = init_map;
 				}
 			}
 			inline void growTrees(){
-#pragma omp parallel for num_threads(fpSingleton::getSingleton().returnNumThreads())
+#pragma omp parallel for num_threads(context->returnNumThreads())
 				for(int i = 0; i < (int)trees.size(); ++i){
 					trees[i].growTree();
 					trees[i].updateSimMat(simMat, pairMat);
@@ -66,7 +68,7 @@ namespace fp {
 
 			inline void createSparseMat(){
 				//Not in use now. TODO: Remove entirely?
-				auto numObs = fpSingleton::getSingleton().returnNumObservations();
+				auto numObs = context->returnNumObservations();
 				SpMat eigenSimMat(numObs, numObs);
 				for (auto it=pairMat.begin(); it!=pairMat.end(); ++it){
 					int i = (it->first).first;
@@ -96,7 +98,7 @@ namespace fp {
 				int totalLeafDepth=0;
 
 				int tempMaxDepth;
-				for(int i = 0; i < fpSingleton::getSingleton().returnNumTrees(); ++i){
+				for(int i = 0; i < context->returnNumTrees(); ++i){
 					tempMaxDepth = trees[i].returnMaxDepth();
 					maxDepth = ((maxDepth < tempMaxDepth) ? tempMaxDepth : maxDepth);
 
@@ -134,6 +136,41 @@ namespace fp {
 				std::cout << "Not defined for unsupervised random forests. \n";
 				return 0;
 			}
+			inline void predictBatch(const T *X, int numObservations, int numFeatures, bool rowMajor, int *predictions)
+			{
+				std::cout << "Not defined for unsupervised random forests. \n";
+			}
+
+			//an unsupervised forest is saved as its similarity pairs.
+			inline void saveForest(forestFileWriter& forestFile){
+				std::vector<int> firstObservations;
+				std::vector<int> secondObservations;
+				std::vector<double> similarities;
+				for(auto& pair : pairMat){
+					firstObservations.push_back(pair.first.first);
+					secondObservations.push_back(pair.first.second);
+					similarities.push_back(pair.second);
+				}
+				forestFile.writeArray(firstObservations);
+				forestFile.writeArray(secondObservations);
+				forestFile.writeArray(similarities);
+			}
+
+			inline void loadForest(forestFileReader& forestFile){
+				std::vector<int> firstObservations;
+				std::vector<int> secondObservations;
+				std::vector<double> similarities;
+				forestFile.readArray(firstObservations);
+				forestFile.readArray(secondObservations);
+				forestFile.readArray(similarities);
+				if(secondObservations.size() != firstObservations.size() || similarities.size() != firstObservations.size()){
+					throw std::runtime_error("saved similarity pairs differ in length.");
+				}
+				pairMat.clear();
+				for(unsigned int i = 0; i < similarities.size(); ++i){
+					pairMat[std::make_pair(firstObservations[i], secondObservations[i])] = similarities[i];
+				}
+			}
 			inline std::vector<int> predictClassPost(std::vector<T> &observation)
 			{
 				std::cout << "Not defined for unsupervised random forests. \n";
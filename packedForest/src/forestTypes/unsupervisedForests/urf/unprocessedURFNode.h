@@ -20,15 +20,15 @@ namespace fp{
 				//std::random_device rd;
 				//The next three should be static
 				//std::mt19937 rng(rd());   
-				//std::uniform_int_distribution<int> randomMtry(0,fpSingleton::getSingleton().returnMtry()-1);
-				//std::uniform_int_distribution<int> randomFeature(0,fpSingleton::getSingleton().returnNumFeatures()-1);
+				//std::uniform_int_distribution<int> randomMtry(0,this->context->returnMtry()-1);
+				//std::uniform_int_distribution<int> randomFeature(0,this->context->returnNumFeatures()-1);
 				//Example: auto random_integer = uni(rng);
 
 			public:
-                                unprocessedURFNode(int numObsForRoot): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(numObsForRoot), featuresToTry(fpSingleton::getSingleton().returnMtry()){}
+                                unprocessedURFNode(fpContext& forestContext, int numObsForRoot): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(forestContext, numObsForRoot), featuresToTry(forestContext.returnMtry()){}
 
 
-                                unprocessedURFNode(int parentID, int dep, bool isLeft): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(parentID, dep, isLeft){
+                                unprocessedURFNode(fpContext& forestContext, int parentID, int dep, bool isLeft): baseUnprocessedNodeUnsupervised<T>::baseUnprocessedNodeUnsupervised(forestContext, parentID, dep, isLeft){
 }
 
 				~unprocessedURFNode(){}
@@ -55,7 +55,7 @@ namespace fp{
 				}
 
 				inline void pickMTRY(){
-					for (int i=0; i < fpSingleton::getSingleton().returnNumFeatures(); ++i){
+					for (int i=0; i < this->context->returnNumFeatures(); ++i){
 						featuresToTry.push_back(i);
 					}
                                         std::random_device rd; // obtain a random number from hardware
@@ -63,33 +63,33 @@ namespace fp{
 
                                         int tempSwap;
 
-                                        for(int locationToMove = 0; locationToMove < fpSingleton::getSingleton().returnMtry(); locationToMove++){
-                                                std::uniform_int_distribution<> distr(locationToMove, fpSingleton::getSingleton().returnNumFeatures()-1);
+                                        for(int locationToMove = 0; locationToMove < this->context->returnMtry(); locationToMove++){
+                                                std::uniform_int_distribution<> distr(locationToMove, this->context->returnNumFeatures()-1);
                                                 int randomPosition = distr(eng);
                                                 tempSwap = featuresToTry[locationToMove];
                                                 featuresToTry[locationToMove] = featuresToTry[randomPosition];
                                                 featuresToTry[randomPosition] = tempSwap;
                                         }
-                                        featuresToTry.resize(fpSingleton::getSingleton().returnMtry());
+                                        featuresToTry.resize(this->context->returnMtry());
 				}
 
 				inline void loadFeatureHolder(){
 					if(baseUnprocessedNodeUnsupervised<T>::obsIndices->useBin()){
 						for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedSize(); ++i){
-							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
+							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnBinnedInSample(i));
 						}
 					}else{
 
 						for(int q=0; q<baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); q++){
-							fpSingleton::getSingleton().prefetchFeatureVal(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
+							this->context->template prefetchFeatureVal<T>(featuresToTry.back(),baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(q));
 						}
 
 						for(int i =0; i < baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSampleSize(); ++i){
-							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = fpSingleton::getSingleton().returnFeatureVal(featuresToTry.back(), baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
+							baseUnprocessedNodeUnsupervised<T>::featureHolder[i] = this->context->template returnFeatureVal<T>(featuresToTry.back(), baseUnprocessedNodeUnsupervised<T>::obsIndices->returnInSample(i));
 						}
 					}
 				}
@@ -102,7 +102,7 @@ namespace fp{
 
 
 				inline bool goLeft(const int index){
-					T featureVal = fpSingleton::getSingleton().returnFeatureVal(bestSplitInfo.returnFeatureNum(),index);
+					T featureVal = this->context->template returnFeatureVal<T>(bestSplitInfo.returnFeatureNum(),index);
 
 					if(featureVal <= bestSplitInfo.returnSplitValue()){
 						return true;
@@ -118,8 +118,8 @@ namespace fp{
 
 				inline void moveDataLeftOrRight(){
 
-					baseUnprocessedNodeUnsupervised<T>::leftIndices = new stratifiedInNodeClassIndicesUnsupervised();
-					baseUnprocessedNodeUnsupervised<T>::rightIndices = new stratifiedInNodeClassIndicesUnsupervised();
+					baseUnprocessedNodeUnsupervised<T>::leftIndices = new stratifiedInNodeClassIndicesUnsupervised(*this->context);
+					baseUnprocessedNodeUnsupervised<T>::rightIndices = new stratifiedInNodeClassIndicesUnsupervised(*this->context);
 
 					int lNum =0;
 					int rNum =0;
@@ -19,6 +19,7 @@ namespace fp{
 		class urfTree
 		{
 			protected:
+				fpContext* context;
 				float OOBAccuracy;
 				float correctOOB;
 				float totalOOB;
@@ -27,18 +28,18 @@ namespace fp{
 				std::vector< unprocessedURFNode<T> > leafNodes;
 
 			public:
-				urfTree() : OOBAccuracy(-1.0),correctOOB(0),totalOOB(0){}
+				urfTree(fpContext& forestContext) : context(&forestContext), OOBAccuracy(-1.0),correctOOB(0),totalOOB(0){}
 
 				void loadFirstNode(){
-					nodeQueue.emplace_back(fpSingleton::getSingleton().returnNumObservations());
+					nodeQueue.emplace_back(*context, context->returnNumObservations());
 				}
 
 				inline bool shouldProcessNode(){
 					if(nodeQueue.back().returnNodeImpurity() < std::numeric_limits<T>::epsilon())
 						return false;
-					if(nodeQueue.back().returnInSampleSize() <= fpSingleton::getSingleton().returnMinParent())
+					if(nodeQueue.back().returnInSampleSize() <= context->returnMinParent())
 						return false;
-                			if(nodeQueue.back().returnDepth() >= fpSingleton::getSingleton().returnMaxDepth())
+                			if(nodeQueue.back().returnDepth() >= context->returnMaxDepth())
                           			return false;
 					return true;
 				}
@@ -201,10 +202,10 @@ namespace fp{
 
 					nodeQueue.pop_back();
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isLeftNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isLeftNode());
 					nodeQueue.back().loadIndices(leftIndices);
 
-					nodeQueue.emplace_back(returnLastNodeID(),childDepth, isRightNode());
+					nodeQueue.emplace_back(*context, returnLastNodeID(),childDepth, isRightNode());
 					nodeQueue.back().loadIndices(rightIndices);
 				}
 
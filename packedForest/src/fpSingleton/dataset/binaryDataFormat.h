@@ -0,0 +1,225 @@
+#ifndef binaryDataFormat_h
+#define binaryDataFormat_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "inputData.h"
+#include "../../baseFunctions/mappedFile.h"
+
+namespace fp {
+
+	/**
+	 * Binary dataset format.  Every field is written in the byte order of
+	 * the machine that wrote the file; endianTag lets a reader detect a
+	 * mismatch.
+	 *
+	 *   offset  bytes  field
+	 *   0       8      magic "FPDATA" padded with zeros
+	 *   8       4      format version
+	 *   12      4      endian tag 0x01020304
+	 *   16      4      X element type (1 double, 2 float, 3 uint8)
+	 *   20      4      Y element type (1 int32)
+	 *   24      8      number of observations
+	 *   32      8      number of features
+	 *   40      8      number of classes
+	 *   48      8      byte offset of the X block
+	 *   56      8      byte offset of the Y block
+	 *
+	 * The X block holds numFeatures columns back to back, each one
+	 * numObservations values long, so feature f of observation i is element
+	 * f*numObservations+i.  The X block starts on a page boundary and the Y
+	 * block (one int32 label per observation) on a cache line boundary.
+	 */
+
+	struct binaryDataHeader{
+		char magic[8];
+		uint32_t version;
+		uint32_t endianTag;
+		uint32_t xType;
+		uint32_t yType;
+		uint64_t numObservations;
+		uint64_t numFeatures;
+		uint64_t numClasses;
+		uint64_t xOffset;
+		uint64_t yOffset;
+	};
+
+	static_assert(sizeof(binaryDataHeader) == 64, "binaryDataHeader must be 64 bytes.");
+
+	const char binaryDataMagic[8] = {'F','P','D','A','T','A','\0','\0'};
+	const uint32_t binaryDataVersion = 1;
+	const uint32_t binaryDataEndianTag = 0x01020304;
+	const uint64_t binaryDataXAlignment = 4096;
+	const uint64_t binaryDataYAlignment = 64;
+
+
+	template <typename T>
+		struct binaryElementType;
+
+	template <>
+		struct binaryElementType<double>{ static const uint32_t value = 1; };
+
+	template <>
+		struct binaryElementType<float>{ static const uint32_t value = 2; };
+
+	template <>
+		struct binaryElementType<uint8_t>{ static const uint32_t value = 3; };
+
+	template <typename Q>
+		struct binaryLabelType;
+
+	template <>
+		struct binaryLabelType<int32_t>{ static const uint32_t value = 1; };
+
+
+	inline uint64_t roundUpToMultiple(const uint64_t value, const uint64_t multiple){
+		return ((value + multiple - 1) / multiple) * multiple;
+	}
+
+
+	/**
+	 * binaryDataFile maps a binary dataset and validates its header.  The
+	 * blocks are returned as pointers into the mapping so nothing is copied.
+	 */
+
+	class binaryDataFile
+	{
+		protected:
+			mappedFile dataFile;
+			binaryDataHeader header;
+
+			//count elements of elementSize bytes starting at offset lie
+			//within the file.  Compared by subtraction so values from a
+			//corrupt header cannot wrap.
+			inline bool isBlockInFile(const uint64_t offset, const uint64_t count, const uint64_t elementSize){
+				return offset <= dataFile.returnSize() && count <= (dataFile.returnSize()-offset)/elementSize;
+			}
+
+		public:
+			binaryDataFile(const std::string& binaryFileName) : dataFile(binaryFileName){
+				if(dataFile.returnSize() < sizeof(binaryDataHeader)){
+					throw std::runtime_error("file is not a binary dataset." );
+				}
+				std::memcpy(&header, dataFile.returnData(), sizeof(binaryDataHeader));
+
+				if(std::memcmp(header.magic, binaryDataMagic, sizeof(binaryDataMagic)) != 0){
+					throw std::runtime_error("file is not a binary dataset." );
+				}
+				if(header.endianTag != binaryDataEndianTag){
+					throw std::runtime_error("binary dataset was written with a different byte order." );
+				}
+				if(header.version != binaryDataVersion){
+					throw std::runtime_error("unsupported binary dataset version." );
+				}
+				if(header.numObservations > (uint64_t)std::numeric_limits<int>::max() || header.numFeatures > (uint64_t)std::numeric_limits<int>::max()){
+					throw std::runtime_error("binary dataset is too large." );
+				}
+			}
+
+			static bool isBinaryDataset(const std::string& fileName){
+				std::ifstream fileHandle(fileName, std::ios::binary);
+				char magic[sizeof(binaryDataMagic)];
+				if(!fileHandle.read(magic, sizeof(magic))){
+					return false;
+				}
+				return std::memcmp(magic, binaryDataMagic, sizeof(binaryDataMagic)) == 0;
+			}
+
+			template <typename T>
+				inline const T* returnXBlock(){
+					if(header.xType != binaryElementType<T>::value){
+						throw std::runtime_error("binary dataset element type does not match the forest data type." );
+					}
+					if(header.xOffset % binaryDataXAlignment != 0){
+						throw std::runtime_error("binary dataset X block is misaligned." );
+					}
+					//both counts are at most INT_MAX, so the product cannot wrap.
+					if(!isBlockInFile(header.xOffset, header.numFeatures*header.numObservations, sizeof(T))){
+						throw std::runtime_error("binary dataset is truncated." );
+					}
+					return reinterpret_cast<const T*>(dataFile.returnData() + header.xOffset);
+				}
+
+			template <typename Q>
+				inline const Q* returnYBlock(){
+					if(header.yType != binaryLabelType<Q>::value){
+						throw std::runtime_error("binary dataset label type does not match." );
+					}
+					if(header.yOffset % alignof(Q) != 0){
+						throw std::runtime_error("binary dataset Y block is misaligned." );
+					}
+					if(!isBlockInFile(header.yOffset, header.numObservations, sizeof(Q))){
+						throw std::runtime_error("binary dataset is truncated." );
+					}
+					return reinterpret_cast<const Q*>(dataFile.returnData() + header.yOffset);
+				}
+
+			inline int returnHeaderNumObservations(){
+				return (int)header.numObservations;
+			}
+
+			inline int returnHeaderNumFeatures(){
+				return (int)header.numFeatures;
+			}
+
+			inline int returnHeaderNumClasses(){
+				return (int)header.numClasses;
+			}
+	};
+
+
+	/**
+	 * Writes any training set to the binary dataset format.  Columns are
+	 * written one at a time so only one column is buffered.
+	 */
+	template <typename T, typename Q>
+		inline void writeBinaryDataset(const std::string& binaryFileName, inputData<T,Q>& data){
+			binaryDataHeader header;
+			std::memset(&header, 0, sizeof(header));
+			std::memcpy(header.magic, binaryDataMagic, sizeof(binaryDataMagic));
+			header.version = binaryDataVersion;
+			header.endianTag = binaryDataEndianTag;
+			header.xType = binaryElementType<T>::value;
+			header.yType = binaryLabelType<int32_t>::value;
+			header.numObservations = data.returnNumObservations();
+			header.numFeatures = data.returnNumFeatures();
+			header.numClasses = data.returnNumClasses();
+			header.xOffset = roundUpToMultiple(sizeof(binaryDataHeader), binaryDataXAlignment);
+			header.yOffset = roundUpToMultiple(header.xOffset + header.numFeatures*header.numObservations*sizeof(T), binaryDataYAlignment);
+
+			std::ofstream binaryFile(binaryFileName, std::ios::binary | std::ios::trunc);
+			if(!binaryFile.good()){
+				throw std::runtime_error("Unable to open file." );
+			}
+
+			std::vector<char> padding(binaryDataXAlignment, 0);
+			binaryFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			binaryFile.write(padding.data(), header.xOffset - sizeof(header));
+
+			std::vector<T> column(header.numObservations);
+			for(int feature = 0; feature < (int)header.numFeatures; ++feature){
+				for(int obs = 0; obs < (int)header.numObservations; ++obs){
+					column[obs] = data.returnFeatureValue(feature, obs);
+				}
+				binaryFile.write(reinterpret_cast<const char*>(column.data()), column.size()*sizeof(T));
+			}
+			binaryFile.write(padding.data(), header.yOffset - (header.xOffset + header.numFeatures*header.numObservations*sizeof(T)));
+
+			std::vector<int32_t> labels(header.numObservations);
+			for(int obs = 0; obs < (int)header.numObservations; ++obs){
+				labels[obs] = data.returnClassOfObservation(obs);
+			}
+			binaryFile.write(reinterpret_cast<const char*>(labels.data()), labels.size()*sizeof(int32_t));
+
+			if(!binaryFile.good()){
+				throw std::runtime_error("Unable to write binary dataset." );
+			}
+		}
+
+} //namespace fp
+#endif //binaryDataFormat_h
@@ -0,0 +1,57 @@
+#ifndef dataAccessors_h
+#define dataAccessors_h
+
+#include <cstddef>
+#include "../../baseFunctions/buildSpecific.h"
+
+namespace fp {
+
+	/**
+	 * Data accessors read training features straight from the strided
+	 * array that holds them.  The split code is templated on the accessor
+	 * so the layout is known at compile time and a feature lookup inlines
+	 * to a single load instead of a trip through fpData and a virtual call.
+	 * Every training set is stored in one of these two layouts.
+	 */
+
+	template <typename T>
+		class colMajorAccessor
+		{
+			protected:
+				const T* xData;
+				size_t numObs;
+
+			public:
+				colMajorAccessor(const T* Xmat, const int numObservations) : xData(Xmat), numObs(numObservations){}
+
+				inline T returnFeatureValue(const int featureNum, const int observationNum) const{
+					return xData[numObs*featureNum + observationNum];
+				}
+
+				inline void prefetchFeatureValue(const int featureNum, const int observationNum) const{
+					PREFETCHGATHER(&xData[numObs*featureNum + observationNum]);
+				}
+		};
+
+
+	template <typename T>
+		class rowMajorAccessor
+		{
+			protected:
+				const T* xData;
+				size_t numFeatures;
+
+			public:
+				rowMajorAccessor(const T* Xmat, const int numberOfFeatures) : xData(Xmat), numFeatures(numberOfFeatures){}
+
+				inline T returnFeatureValue(const int featureNum, const int observationNum) const{
+					return xData[numFeatures*observationNum + featureNum];
+				}
+
+				inline void prefetchFeatureValue(const int featureNum, const int observationNum) const{
+					PREFETCHGATHER(&xData[numFeatures*observationNum + featureNum]);
+				}
+		};
+
+} //namespace fp
+#endif //dataAccessors_h
@@ -76,35 +76,41 @@ namespace fp {
 		class inputXData
 		{
 			private:
-				std::vector < std::vector<T> > XData;
+				//column major, one contiguous run of observations per feature.
+				std::vector<T> XData;
+				int numFeatures = 0;
+				int numObservations = 0;
 
 			public:
 				virtual ~inputXData(){}
 				void initializeXData( const int &numFeatures, const int &numObservations){
-					XData.resize(numFeatures);
-					for (int i=0; i<numFeatures; i++){
-						XData[i].resize(numObservations);
-					}
+					this->numFeatures = numFeatures;
+					this->numObservations = numObservations;
+					XData.resize((size_t)numFeatures*numObservations);
 				}
 
 				inline T returnElement(const int &feature, const int &observation){
-					return XData[feature][observation];
+					return XData[(size_t)numObservations*feature + observation];
 				}
 
 				inline void prefetchElement(const int &feature, const int &observation){
-					PREFETCHGATHER(&XData[feature][observation]);
+					PREFETCHGATHER(&XData[(size_t)numObservations*feature + observation]);
 				}
 
 				inline void setXElement( const int &feature, const int &observation, const T &value){
-					XData[feature][observation] = value;
+					XData[(size_t)numObservations*feature + observation] = value;
+				}
+
+				inline const T* returnXData(){
+					return XData.data();
 				}
 
 				inline int returnNumFeatures(){
-					return XData.size();
+					return numFeatures;
 				}
 
 				inline int returnNumObservations(){
-					return XData[0].size();
+					return numObservations;
 				}
 		};
 
@@ -145,19 +151,33 @@ namespace fp {
 		};//testXData
 
 
+	/**
+	 * testDataBase is the part of testData that does not depend on the
+	 * feature storage type (see inputDataBase).
+	 */
+	template <typename Q>
+		class testDataBase
+		{
+			public:
+				virtual ~testDataBase(){}
+				virtual Q returnClassOfObservation(const int &observationNum) = 0;
+				virtual int returnNumFeatures() = 0;
+				virtual int returnNumObservations() = 0;
+				virtual int returnNumClasses() = 0;
+		};
+
+
 	template <typename T, typename Q>
-		class testData
+		class testData : public testDataBase<Q>
 		{
 			private:
 				testXData<T> X;
 				inputYDataClassification<Q> Y;
 
 			public:
-				testData(const std::string& forestCSVFileName, const int &columnWithY)
+				testData(const std::string& forestCSVFileName, const int &columnWithY, const int numThreads = 1)
 				{
-
-					//			csvHandle<T> csvH(forestCSVFileName);
-					csvHandle csvH(forestCSVFileName);
+					csvHandle csvH(forestCSVFileName, numThreads);
 					if(columnWithY >= csvH.returnNumColumns()){
 						throw std::runtime_error("column with class labels does not exist." );
 						return;
@@ -166,17 +186,7 @@ namespace fp {
 					X.initializeTestXData(csvH.returnNumColumns()-1, csvH.returnNumRows());
 					Y.initializeYData(csvH.returnNumRows());
 
-					for(int i=0; i<csvH.returnNumRows(); i++){
-						for(int j=0; j<csvH.returnNumColumns(); j++){
-							if(j < columnWithY){
-								X.setXElement(j,i, csvH.returnNextElement<T>());
-							}else if(j == columnWithY){
-								Y.setYElement(i, csvH.returnNextElement<Q>());
-							}else{
-								X.setXElement(j-1,i, csvH.returnNextElement<T>());
-							}
-						}
-					}
+					csvH.parseXAndY<T,Q>(X, Y, columnWithY, numThreads);
 				}
 
 				inline Q returnClassOfObservation(const int &observationNum){
@@ -207,7 +217,7 @@ namespace fp {
 				void printXValues(){
 					for(int i = 0; i < this->returnNumFeatures(); i++){
 						for(int j = 0; j < this->returnNumObservations(); j++){
-							std::cout << this->returnFeatureValue(i,j) << " ";
+							std::cout << +this->returnFeatureValue(i,j) << " ";
 						}
 						std::cout << "\n";
 					}
@@ -1,73 +1,241 @@
 #ifndef fpReadCSV_h
 #define fpReadCSV_h
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <exception>
+#include <stdexcept>
+#include "../../baseFunctions/mappedFile.h"
 
 
 namespace fp {
 
 	/**
-	 * fpReadCSV makes two passes over a csv file.  This could be bad if
-	 * the csv file is large.  The first pass makes sure the csv file
-	 * is structured correctly and collects basic info about the csv:
-	 * number of rows and columns.  The file handle is then returned to
-	 * the beginning of the file and returns individual elements in order.
+	 * Whether value survives conversion to T unchanged.  Any value fits a
+	 * floating point T; an integer T needs a whole number within its range.
+	 */
+	template <typename T>
+		inline bool fitsCSVValueType(const double value){
+			if(!std::is_integral<T>::value){
+				return true;
+			}
+			return value == std::floor(value) && value >= (double)std::numeric_limits<T>::lowest() && value <= (double)std::numeric_limits<T>::max();
+		}
+
+
+	/**
+	 * parseCSVNumber reads one number starting at pos and leaves pos on the
+	 * first character after it.  Numbers with at most 19 significant digits
+	 * and a decimal exponent within +-22 are converted exactly with a single
+	 * multiply or divide by a power of ten.  Anything else (long mantissas,
+	 * large exponents, inf, nan) falls back to strtod.
+	 */
+	inline double parseCSVNumber(const char*& pos, const char* end){
+		static const double exactPowersOfTen[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+		while(pos < end && (*pos == ' ' || *pos == '\t')){
+			++pos;
+		}
+		const char* numberStart = pos;
+
+		bool negative = false;
+		if(pos < end && (*pos == '-' || *pos == '+')){
+			negative = (*pos == '-');
+			++pos;
+		}
+
+		uint64_t mantissa = 0;
+		int numSignificantDigits = 0;
+		int exponent = 0;
+		bool sawDigit = false;
+		bool exact = true;
+
+		while(pos < end && (unsigned)(*pos - '0') < 10){
+			sawDigit = true;
+			if(numSignificantDigits < 19){
+				mantissa = mantissa*10 + (*pos - '0');
+				if(mantissa){
+					++numSignificantDigits;
+				}
+			}else{
+				exact = false;
+			}
+			++pos;
+		}
+
+		if(pos < end && *pos == '.'){
+			++pos;
+			while(pos < end && (unsigned)(*pos - '0') < 10){
+				sawDigit = true;
+				if(numSignificantDigits < 19){
+					mantissa = mantissa*10 + (*pos - '0');
+					if(mantissa){
+						++numSignificantDigits;
+					}
+					--exponent;
+				}else if(*pos != '0'){
+					exact = false;
+				}
+				++pos;
+			}
+		}
+
+		if(sawDigit && pos < end && (*pos == 'e' || *pos == 'E')){
+			const char* exponentStart = pos;
+			++pos;
+			bool negativeExponent = false;
+			if(pos < end && (*pos == '-' || *pos == '+')){
+				negativeExponent = (*pos == '-');
+				++pos;
+			}
+			int explicitExponent = 0;
+			bool sawExponentDigit = false;
+			while(pos < end && (unsigned)(*pos - '0') < 10){
+				sawExponentDigit = true;
+				if(explicitExponent < 10000){
+					explicitExponent = explicitExponent*10 + (*pos - '0');
+				}
+				++pos;
+			}
+			if(sawExponentDigit){
+				exponent += negativeExponent ? -explicitExponent : explicitExponent;
+			}else{
+				pos = exponentStart;
+			}
+		}
+
+		if(sawDigit && exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22){
+			double value = (double)mantissa;
+			value = exponent < 0 ? value / exactPowersOfTen[-exponent] : value * exactPowersOfTen[exponent];
+			return negative ? -value : value;
+		}
+
+		// strtod needs a terminated string and the mapped file is not.
+		char numberBuffer[128];
+		size_t numberLength = 0;
+		while(numberStart + numberLength < end && numberLength < sizeof(numberBuffer)-1){
+			char c = numberStart[numberLength];
+			if(c == ',' || c == '\n' || c == '\r'){
+				break;
+			}
+			numberBuffer[numberLength++] = c;
+		}
+		numberBuffer[numberLength] = '\0';
+		char* parseEnd;
+		double value = std::strtod(numberBuffer, &parseEnd);
+		pos = numberStart + (parseEnd - numberBuffer);
+		return value;
+	}
+
+
+	/**
+	 * csvHandle reads a csv file through a memory map.  The constructor
+	 * splits the file into newline aligned chunks, then counts the rows in
+	 * each chunk and checks their lengths in parallel (memchr and comma
+	 * counting only, no number parsing).  parseRows then parses every chunk
+	 * in parallel and hands each value to a callback along with its row and
+	 * column so the caller can write it straight to its final location.
+	 * Blank lines are skipped.
 	 */
 
 	class csvHandle
 	{
 		private:
-			std::ifstream streamHandle;
+			mappedFile csvFile;
 			int numberOfRows;
 			int numberOfColumns;
+			std::vector<size_t> chunkStarts;
+			std::vector<int> chunkFirstRow;
+			const char* readPosition;
 
-		public:
-			~csvHandle(){
-				streamHandle.close();
+			static const size_t minChunkSize = 1 << 16;
+
+			inline static const char* findLineEnd(const char* pos, const char* end){
+				const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', end-pos));
+				return lineEnd == NULL ? end : lineEnd;
 			}
 
-			csvHandle(const std::string& forestCSVFileName) : numberOfRows(0), numberOfColumns(0){
+			inline static bool isBlankLine(const char* lineStart, const char* lineEnd){
+				return lineStart == lineEnd || (lineEnd - lineStart == 1 && *lineStart == '\r');
+			}
 
-				streamHandle.open(forestCSVFileName);
-				numberOfRows = 0;
+			inline const char* returnChunkStart(const int chunk){
+				return csvFile.returnData() + chunkStarts[chunk];
+			}
 
-				if(!streamHandle.good()){
-					throw std::runtime_error("Unable to open file." );
-					return;
+			//returns -1 if a row in the chunk has the wrong number of columns.
+			inline int countRowsInChunk(const int chunk){
+				const char* pos = returnChunkStart(chunk);
+				const char* chunkEnd = returnChunkStart(chunk+1);
+				int rowsInChunk = 0;
+				while(pos < chunkEnd){
+					const char* lineEnd = findLineEnd(pos, chunkEnd);
+					if(!isBlankLine(pos, lineEnd)){
+						if(1 + std::count(pos, lineEnd, ',') != numberOfColumns){
+							return -1;
+						}
+						++rowsInChunk;
+					}
+					pos = lineEnd+1;
 				}
+				return rowsInChunk;
+			}
+
+		public:
+			csvHandle(const std::string& forestCSVFileName, const int numThreads = 1) : csvFile(forestCSVFileName), numberOfRows(0), numberOfColumns(0){
+				csvFile.adviseSequential();
+				const char* fileStart = csvFile.returnData();
+				const char* fileEnd = fileStart + csvFile.returnSize();
+				readPosition = fileStart;
 
-				while(streamHandle){
-					std::string row;
-					if(!getline(streamHandle, row))
-					{
+				for(const char* pos = fileStart; pos < fileEnd;){
+					const char* lineEnd = findLineEnd(pos, fileEnd);
+					if(!isBlankLine(pos, lineEnd)){
+						numberOfColumns = 1 + std::count(pos, lineEnd, ',');
 						break;
 					}
-					++numberOfRows;
+					pos = lineEnd+1;
+				}
 
-					std::istringstream stringStream(row);
+				size_t numChunks = csvFile.returnSize() / minChunkSize;
+				if(numChunks > (size_t)numThreads){
+					numChunks = numThreads;
+				}
+				if(numChunks < 1){
+					numChunks = 1;
+				}
 
-					std::string value;
-					int tempNumberOfColumns = 0;
-					while(stringStream)
-					{
-						if(!getline(stringStream,value,',')){
-							break;
-						}
-						++tempNumberOfColumns;
-					}
-					if(!numberOfColumns){
-						numberOfColumns = tempNumberOfColumns; 
-					}
-					if(numberOfColumns != tempNumberOfColumns){
+				chunkStarts.resize(numChunks+1);
+				chunkStarts[0] = 0;
+				chunkStarts[numChunks] = csvFile.returnSize();
+				for(size_t i = 1; i < numChunks; ++i){
+					const char* approximateStart = fileStart + std::max(chunkStarts[i-1], i*csvFile.returnSize()/numChunks);
+					const char* lineEnd = findLineEnd(approximateStart, fileEnd);
+					chunkStarts[i] = lineEnd == fileEnd ? csvFile.returnSize() : (size_t)(lineEnd+1-fileStart);
+				}
+
+				chunkFirstRow.resize(numChunks+1);
+#pragma omp parallel for num_threads(numThreads) schedule(static,1)
+				for(int chunk = 0; chunk < (int)numChunks; ++chunk){
+					chunkFirstRow[chunk+1] = countRowsInChunk(chunk);
+				}
+				chunkFirstRow[0] = 0;
+				for(size_t i = 1; i <= numChunks; ++i){
+					if(chunkFirstRow[i] < 0){
 						throw std::runtime_error("uneven row lengths in csv file." );
-						return;
 					}
+					chunkFirstRow[i] += chunkFirstRow[i-1];
 				}
-				streamHandle.clear(); // clear fail and eof bits
-				streamHandle.seekg(0, std::ios::beg); // return to beginning of stream
+				numberOfRows = chunkFirstRow[numChunks];
 			}
 
 			void printCSVStats(){
@@ -78,11 +246,133 @@ namespace fp {
 			int returnNumRows(){return numberOfRows;}
 			int returnNumColumns(){return numberOfColumns;}
 
+
+			/**
+			 * Calls storeElement(row, column, value) once for every value in
+			 * the file.  Chunks are processed concurrently so storeElement
+			 * must be safe to call for different rows at the same time.
+			 */
+			template <typename F>
+				inline void parseRows(F storeElement, const int numThreads = 1){
+					int unevenRows = 0;
+					int unreadableValue = 0;
+					const int numChunks = chunkStarts.size()-1;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static,1)
+					for(int chunk = 0; chunk < numChunks; ++chunk){
+						const char* pos = returnChunkStart(chunk);
+						const char* chunkEnd = returnChunkStart(chunk+1);
+						int row = chunkFirstRow[chunk];
+
+						while(pos < chunkEnd){
+							const char* lineEnd = findLineEnd(pos, chunkEnd);
+							if(isBlankLine(pos, lineEnd)){
+								pos = lineEnd+1;
+								continue;
+							}
+							const char* valueEnd = (lineEnd > pos && *(lineEnd-1) == '\r') ? lineEnd-1 : lineEnd;
+
+							for(int column = 0; column < numberOfColumns; ++column){
+								while(pos < valueEnd && (*pos == ' ' || *pos == '\t')){
+									++pos;
+								}
+								const char* valueStart = pos;
+								storeElement(row, column, parseCSVNumber(pos, valueEnd));
+								while(pos < valueEnd && (*pos == ' ' || *pos == '\t')){
+									++pos;
+								}
+								if(pos == valueStart){
+#pragma omp atomic write
+									unreadableValue = 1;
+								}
+								if(column < numberOfColumns-1){
+									if(pos < valueEnd && *pos == ','){
+										++pos;
+									}else{
+#pragma omp atomic write
+										unevenRows = 1;
+										break;
+									}
+								}
+							}
+							if(pos != valueEnd){
+								if(*pos == ','){
+#pragma omp atomic write
+									unevenRows = 1;
+								}else{
+#pragma omp atomic write
+									unreadableValue = 1;
+								}
+							}
+							pos = lineEnd+1;
+							++row;
+						}
+					}
+
+					if(unevenRows){
+						throw std::runtime_error("uneven row lengths in csv file." );
+					}
+					if(unreadableValue){
+						throw std::runtime_error("unable to parse value in csv file." );
+					}
+				}
+
+
+			/**
+			 * Parses the file into a training or test set: column columnWithY
+			 * goes to Y and the others, in order, to X.  Labels are collected
+			 * first and then set one at a time because setYElement tracks the
+			 * classes seen and is not safe to call concurrently.  Values that
+			 * would change on conversion, such as 5.1 or 300 for a uint8_t
+			 * feature, are rejected rather than truncated.
+			 */
+			template <typename T, typename Q, typename XHolder, typename YHolder>
+				inline void parseXAndY(XHolder& X, YHolder& Y, const int columnWithY, const int numThreads = 1){
+					std::vector<Q> labels(numberOfRows);
+					int unfitFeature = 0;
+					int unfitLabel = 0;
+
+					parseRows([&](const int row, const int column, const double value){
+						if(column == columnWithY){
+							if(!fitsCSVValueType<Q>(value)){
+#pragma omp atomic write
+								unfitLabel = 1;
+								return;
+							}
+							labels[row] = (Q)value;
+							return;
+						}
+						if(!fitsCSVValueType<T>(value)){
+#pragma omp atomic write
+							unfitFeature = 1;
+							return;
+						}
+						X.setXElement(column < columnWithY ? column : column-1, row, (T)value);
+					}, numThreads);
+
+					if(unfitFeature){
+						throw std::runtime_error("csv feature value does not fit the feature type." );
+					}
+					if(unfitLabel){
+						throw std::runtime_error("csv class label does not fit the label type." );
+					}
+
+					for(int i=0; i<numberOfRows; i++){
+						Y.setYElement(i, labels[i]);
+					}
+				}
+
+
 			template <class T>
 				inline T returnNextElement(){
-					T temp;
-					streamHandle >> temp;
-					streamHandle.ignore(1, ',');
+					const char* fileEnd = csvFile.returnData() + csvFile.returnSize();
+					while(readPosition < fileEnd && (*readPosition == '\n' || *readPosition == '\r')){
+						++readPosition;
+					}
+					T temp = (T)parseCSVNumber(readPosition, fileEnd);
+					if(readPosition < fileEnd && *readPosition == ','){
+						++readPosition;
+					}
 					return temp;
 				}
 	};
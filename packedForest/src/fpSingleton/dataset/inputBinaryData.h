@@ -0,0 +1,45 @@
+#ifndef inputBinaryData_h
+#define inputBinaryData_h
+
+#include <string>
+#include "binaryDataFormat.h"
+#include "inputMatrixDataColMajor.h"
+#include "inputCSVData.h"
+
+namespace fp
+{
+
+	/**
+	 * inputBinaryData serves a binary dataset (see binaryDataFormat.h)
+	 * directly from the mapped file.  The X block is already column major so
+	 * this is a column major matrix whose pointers point into the mapping;
+	 * nothing is parsed or copied and processes training on the same file
+	 * share its pages through the page cache.
+	 */
+
+	template <typename T, typename Q>
+		class inputBinaryData : private binaryDataFile, public inputMatrixDataColMajor<T, Q>
+	{
+		public:
+			inputBinaryData(const std::string& binaryFileName) : binaryDataFile(binaryFileName),
+			inputMatrixDataColMajor<T, Q>(returnXBlock<T>(), returnYBlock<Q>(), returnHeaderNumObservations(), returnHeaderNumFeatures())
+		{
+			if(this->returnHeaderNumClasses() != this->numClasses){
+				throw std::runtime_error("binary dataset class count does not match its labels." );
+			}
+		}
+	};
+
+
+	/**
+	 * Converts a csv file to the binary dataset format.  The values are
+	 * stored as T so the file can only be loaded by forests using T.
+	 */
+	template <typename T>
+		inline void convertCSVToBinary(const std::string& CSVFileName, const int columnWithY, const std::string& binaryFileName, const int numThreads = 1){
+			inputCSVData<T, int> csvData(CSVFileName, columnWithY, numThreads);
+			writeBinaryDataset(binaryFileName, csvData);
+		}
+
+} // namespace fp
+#endif // inputBinaryData_h
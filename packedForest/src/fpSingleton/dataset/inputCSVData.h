@@ -7,8 +7,6 @@
 #include "inputData.h"
 #include <string>
 
-//#define HOLDSIZE 128
-
 namespace fp {
 
 	template <typename T, typename Q>
@@ -17,74 +15,21 @@ namespace fp {
 		private:
 			inputXData<T> X;
 			inputYDataClassification<Q> Y;
-			//std::vector<std::vector<T> > dataTempStore;
 
 		public:
-			inputCSVData(const std::string& forestCSVFileName, const int &columnWithY)
+			inputCSVData(const std::string& forestCSVFileName, const int &columnWithY, const int numThreads = 1)
 			{
-				csvHandle csvH(forestCSVFileName);
-
-
+				csvHandle csvH(forestCSVFileName, numThreads);
 
 				if(columnWithY >= csvH.returnNumColumns()){
 					throw std::runtime_error("column with class labels does not exist." );
 					return;
 				}
 
-
 				X.initializeXData(csvH.returnNumColumns()-1, csvH.returnNumRows());
 				Y.initializeYData(csvH.returnNumRows());
 
-				/*
-					 dataTempStore.resize(csvH.returnNumColumns()-1);
-					 for(auto& i : dataTempStore){
-					 i.resize(HOLDSIZE);
-					 }
-					 int pRow = 0;
-					 for(; pRow < csvH.returnNumRows()-HOLDSIZE; pRow+=HOLDSIZE){
-					 for(int i = 0; i<HOLDSIZE; i++){
-					 for(int j=0; j<csvH.returnNumColumns(); j++){
-					 if(j < columnWithY){
-					 dataTempStore[j][i] = csvH.returnNextElement<T>();
-					 }else if(j == columnWithY){
-					 Y.setYElement(pRow+i, csvH.returnNextElement<Q>());
-					 }else{
-					 dataTempStore[j-1][i] = csvH.returnNextElement<T>();
-					 }
-					 }
-					 }
-					 for(int j=0; j<csvH.returnNumColumns()-1; j++){
-					 for(int k = 0; k < HOLDSIZE; ++k){
-					 X.setXElement(j,k+pRow, dataTempStore[j][k]);
-					 }
-					 }
-					 }
-
-					 for(int i = pRow; i<csvH.returnNumRows(); i++){
-					 for(int j=0; j<csvH.returnNumColumns(); j++){
-					 if(j < columnWithY){
-					 X.setXElement(j,i, csvH.returnNextElement<T>());
-					 }else if(j == columnWithY){
-					 Y.setYElement(i, csvH.returnNextElement<Q>());
-					 }else{
-					 X.setXElement(j-1,i, csvH.returnNextElement<T>());
-					 }
-					 }
-					 }
-					 */
-
-				for(int i=0; i<csvH.returnNumRows(); i++){
-					for(int j=0; j<csvH.returnNumColumns(); j++){
-						if(j < columnWithY){
-							X.setXElement(j,i, csvH.returnNextElement<T>());
-						}else if(j == columnWithY){
-							Y.setYElement(i, csvH.returnNextElement<Q>());
-						}else{
-							X.setXElement(j-1,i, csvH.returnNextElement<T>());
-						}
-					}
-				}
-
+				csvH.parseXAndY<T,Q>(X, Y, columnWithY, numThreads);
 			}
 
 			~inputCSVData(){
@@ -103,6 +48,14 @@ namespace fp {
 				X.prefetchElement(featureNum, observationNum);
 			}
 
+			inline const T* returnXData(){
+				return X.returnXData();
+			}
+
+			inline bool isRowMajor(){
+				return false;
+			}
+
 			inline int returnNumFeatures(){
 				return X.returnNumFeatures();
 			}
@@ -127,7 +80,7 @@ namespace fp {
 			void printXValues(){
 				for(int i = 0; i < this->returnNumFeatures(); i++){
 					for(int j = 0; j < this->returnNumObservations(); j++){
-						std::cout << this->returnFeatureValue(i,j) << " ";
+						std::cout << +this->returnFeatureValue(i,j) << " ";
 					}
 					std::cout << "\n";
 				}
@@ -7,15 +7,21 @@
 
 namespace fp {
 
-	template <typename T, typename Q>
-		class inputData
+	/**
+	 * inputDataBase holds everything about a training set that does not
+	 * depend on the type the features are stored as.  fpData keeps a pointer
+	 * to this base so a single fpData can hold double, float, or uint8
+	 * data.
+	 */
+	template <typename Q>
+		class inputDataBase
 		{
-			private:
+			protected:
 				bool isTrainingData = true;
 
 			public:
 
-				virtual ~inputData(){};
+				virtual ~inputDataBase(){};
 				virtual Q returnClassOfObservation(const int &observationNum){
 					if(!isTrainingData){
 						std::cout << "This is not training data and so does not contain class labels.\n";
@@ -24,8 +30,6 @@ namespace fp {
 					}
 					return -1;
 				}
-				virtual T returnFeatureValue(const int &featureNum, const int &observationNum) = 0;
-				virtual void prefetchFeatureValue(const int &featureNum, const int &observationNum) = 0;
 				virtual int returnNumFeatures() = 0;
 				virtual int returnNumObservations() = 0;
 				virtual int returnNumClasses(){
@@ -44,6 +48,24 @@ namespace fp {
 					}
 				}
 
+				virtual void printXValues() = 0;
+
+				//true if X is stored observation by observation.
+				virtual bool isRowMajor() = 0;
+		};
+
+
+	template <typename T, typename Q>
+		class inputData : public inputDataBase<Q>
+		{
+			public:
+
+				virtual T returnFeatureValue(const int &featureNum, const int &observationNum) = 0;
+				virtual void prefetchFeatureValue(const int &featureNum, const int &observationNum) = 0;
+
+				//start of the strided array holding X, see dataAccessors.h.
+				virtual const T* returnXData() = 0;
+
 				void printDataStats(){
 					std::cout << "there are " << this->returnNumFeatures() << " features.\n";
 					std::cout << "there are " << this->returnNumObservations() << " observations.\n";
@@ -53,14 +75,14 @@ namespace fp {
 					std::cout << std::fixed;
 						for(int j = 0; j < this->returnNumObservations(); j++){
 					for(int i = 0; i < this->returnNumFeatures(); i++){
-							std::cout << std::setprecision(10) << this->returnFeatureValue(i,j) << " ";
+							std::cout << std::setprecision(10) << +this->returnFeatureValue(i,j) << " ";
 						}
 						std::cout << "\n";
 					}
 				}
 
 				void printYValues(){
-					if(isTrainingData){
+					if(this->isTrainingData){
 						for(int j = 0; j < this->returnNumObservations(); j++){
 							std::cout << this->returnClassOfObservation(j) << " ";
 						}
@@ -30,6 +30,10 @@ namespace fp {
 				return inputYData[observationNum];
 			}
 
+			inline const T* returnXData(){
+				return inputXData;
+			}
+
 			inline int returnNumFeatures(){
 				return numFeatures;
 			}
@@ -69,7 +73,7 @@ namespace fp {
 			void printXValues(){
 				for(int i = 0; i < returnNumFeatures(); i++){
 					for(int j = 0; j < returnNumObservations(); j++){
-						std::cout << returnFeatureValue(i,j) << " ";
+						std::cout << +returnFeatureValue(i,j) << " ";
 					}
 					std::cout << "\n";
 				}
@@ -26,6 +26,11 @@ namespace fp
 			{
 				PREFETCHGATHER(&this->inputXData[this->numObs * featureNum + observationNum]);
 			}
+
+			inline bool isRowMajor()
+			{
+				return false;
+			}
 	};
 
 } // namespace fp
@@ -26,6 +26,11 @@ namespace fp
 			{
 				PREFETCHGATHER(&this->inputXData[observationNum * this->numFeatures + featureNum]);
 			}
+
+			inline bool isRowMajor()
+			{
+				return true;
+			}
 	};
 } // namespace fp
 #endif // inputMatrixDataRowMajor_h
@@ -0,0 +1,320 @@
+#ifndef fpContext_h
+#define fpContext_h
+
+#include "fpData.h"
+#include "fpInfo.h"
+#include <string>
+
+namespace fp {
+
+	/**
+	 * fpContext combines the data (fpData), the forest parameters (fpInfo)
+	 * and the random number generator for one forest.  Each fpForest owns
+	 * its own context and hands it to every object it builds, so separate
+	 * forests can train and predict in the same process.
+	 */
+
+	class fpContext{
+
+		private:
+			fpInfo fpForestInfo;
+			fpData data;
+
+			fpContext(const fpContext&);
+			fpContext& operator=(const fpContext&);
+
+
+		public:
+			fpContext(){}
+
+			inline int returnNumTreeBins(){
+				return fpForestInfo.returnNumTreeBins();
+			}
+
+			inline void setNumTreeBins(int numTB){
+				fpForestInfo.setNumTreeBins(numTB);
+			}
+
+			inline void setParameter(const std::string& parameterName, const std::string& parameterValue){
+				fpForestInfo.setParameter(parameterName, parameterValue);
+			}
+
+			inline void setParameter(const std::string& parameterName, const double parameterValue){
+				fpForestInfo.setParameter(parameterName, parameterValue);
+			}
+
+			inline void setParameter(const std::string& parameterName, const int parameterValue){
+				fpForestInfo.setParameter(parameterName, parameterValue);
+			}
+
+			inline void printAllParameters(){
+				fpForestInfo.printAllParameters();
+			}
+
+			inline void printForestType(){
+				fpForestInfo.printForestType();
+			}
+
+			template <typename X>
+			inline void loadData(const X* Xmat, const int* Yvec, int numObs, int numFeatures){
+				data.fpLoadData(Xmat,Yvec,numObs,numFeatures, fpForestInfo);
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline void loadData(){
+				data.fpLoadData<X>(fpForestInfo);
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline void loadTestData(){
+				data.fpLoadTestData<X>(fpForestInfo);
+			}
+
+			inline void deleteData(){
+				data.fpDeleteData();
+			}
+
+			inline void resetContext(){
+				fpForestInfo.resetInfo();
+			}
+
+			inline void deleteTestData(){
+				data.fpDeleteTestData();
+			}
+
+			inline void printXValues(){
+				data.printXValues();
+			}
+
+			inline void setNumFeatures(int numF){
+				fpForestInfo.setNumFeatures(numF);
+			}
+
+			////////////////////////////////////////
+			//Random Number Generator
+			///////////////////////////////////////
+			inline void initializeRandomNumberGenerator(){
+				fpForestInfo.initRandom();
+			}
+
+			inline int genRandom(int range){
+				return fpForestInfo.genRandom(range);
+			}
+
+			///////////////////////////////////////
+			//
+			//////////////////////////////////////
+
+			inline void setNumObservations(int numO){
+				fpForestInfo.setNumObservations(numO);
+			}
+
+			inline void setNumClasses(int numC){
+				fpForestInfo.setNumClasses(numC);
+			}
+
+			inline int returnNumClasses(){
+				return fpForestInfo.returnNumClasses();
+			}
+
+			inline int returnMtry(){
+				return fpForestInfo.returnMtry();
+			}
+
+			inline double returnMtryMult(){
+				return fpForestInfo.returnMtryMult();
+			}
+
+			inline int returnNumHistogramBins(){
+				return fpForestInfo.returnNumHistogramBins();
+			}
+
+			inline int returnSortStrategy(){
+				return fpForestInfo.returnSortStrategy();
+			}
+
+			inline bool returnUseNodeTasks(){
+				return fpForestInfo.returnUseNodeTasks();
+			}
+
+			inline bool returnUseFeatureTasks(){
+				return fpForestInfo.returnUseFeatureTasks();
+			}
+
+			inline double returnSampleFraction(){
+				return fpForestInfo.returnSampleFraction();
+			}
+
+			inline bool returnUseSummedAreaTables(){
+				return fpForestInfo.returnUseSummedAreaTables();
+			}
+
+			inline bool returnComputeOOB(){
+				return fpForestInfo.returnComputeOOB();
+			}
+
+			inline int returnPredictGroupSize(){
+				return fpForestInfo.returnPredictGroupSize();
+			}
+
+			inline int returnDepthIntertwined(){
+				return fpForestInfo.returnDepthIntertwined();
+			}
+
+			inline std::string& returnForestType(){
+				return fpForestInfo.returnForestType();
+			}
+
+			inline int returnNumFeatures(){
+				return fpForestInfo.returnNumFeatures();
+			}
+
+			inline int returnNumObservations() const{
+				return fpForestInfo.returnNumObservations();
+			}
+
+			inline int returnLabel(int observationNumber){
+				return data.returnLabel(observationNumber);
+			}
+
+			inline int returnTestLabel(int observationNumber){
+				return data.returnTestLabel(observationNumber);
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline X returnFeatureVal(const int featureNumber, const int observationNumber){
+				return data.returnFeatureVal<X>(featureNumber, observationNumber);
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline void prefetchFeatureVal(const int featureNumber, const int observationNumber){
+				data.prefetchFeatureVal<X>(featureNumber, observationNumber);
+			}
+
+			//split code reads X through these instead of returnFeatureVal;
+			//check dataIsRowMajor once and run the loop with the matching one.
+			inline bool dataIsRowMajor(){
+				return data.dataIsRowMajor();
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline colMajorAccessor<X> returnColMajorAccessor(){
+				return data.returnColMajorAccessor<X>();
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline rowMajorAccessor<X> returnRowMajorAccessor(){
+				return data.returnRowMajorAccessor<X>();
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline X returnTestFeatureVal(const int featureNumber, const int observationNumber){
+				return data.returnTestFeatureVal<X>(featureNumber, observationNumber);
+			}
+
+			inline int returnNumTrees(){
+				return fpForestInfo.returnNumTrees();
+			}
+
+			inline int returnNumThreads(){
+				return fpForestInfo.returnNumThreads();
+			}
+
+			inline int returnMinParent(){
+				return fpForestInfo.returnMinParent();
+			}
+
+			inline int returnMaxDepth(){
+				return fpForestInfo.returnMaxDepth();
+			}
+
+			inline int returnBinSize(){
+				return fpForestInfo.returnBinSize();
+			}
+
+			inline int returnBinMin(){
+				return fpForestInfo.returnBinSize();
+			}
+
+			inline bool returnUseBinning(){
+				return fpForestInfo.returnUseBinning();
+			}
+
+
+			inline void setDataDependentParameters(){
+				fpForestInfo.setMTRY();
+				initializeRandomNumberGenerator();
+			}
+
+			inline void checkDataDependentParameters(){
+				if(returnUseSummedAreaTables() && returnForestType() != "binnedBaseTern"){
+					throw std::runtime_error("useSummedAreaTables is only supported by binnedBaseTern." );
+				}
+				// For Structured RerF
+				if(fpForestInfo.returnMethodToUse() == 2){
+					if((returnNumFeatures() % returnImageHeight()) != 0){
+						throw std::runtime_error("Specified image height is not a multiple of the number of features." );
+					}
+					if((returnNumFeatures() % returnImageWidth()) != 0){
+						throw std::runtime_error("Specified image width is not a multiple of the number of features." );
+					}
+					if(returnPatchHeightMax() < returnPatchHeightMin()){
+						throw std::runtime_error("Specified patchHeightMax is less than patchHeightMin." );
+					}
+					if(returnPatchWidthMax() < returnPatchWidthMin()){
+						throw std::runtime_error("Specified patchWidthMax is less than patchWidthMin." );
+					}
+					if(returnPatchHeightMax() > returnImageHeight()){
+						throw std::runtime_error("Specified patchHeightMax is greater than the image height." );
+					}
+					if(returnPatchWidthMax() > returnImageWidth()){
+						throw std::runtime_error("Specified patchWidthMax is greater than the image width." );
+					}
+					if(returnPatchHeightMin() <= 0){
+						throw std::runtime_error("Specified patchHeightMin <= 0." );
+					}
+					if(returnPatchWidthMin() <= 0){
+						throw std::runtime_error("Specified patchWidthMin is <= 0." );
+					}
+				}else if(returnUseSummedAreaTables()){
+					throw std::runtime_error("useSummedAreaTables requires methodToUse 2." );
+				}
+			}
+
+
+
+			// For the method in the switch statement
+			inline int returnMethodToUse(){
+			  return fpForestInfo.returnMethodToUse();
+			}
+
+			// For Structured RerF
+			inline int returnImageHeight(){
+			  return fpForestInfo.returnImageHeight();
+			}
+
+			inline int returnImageWidth(){
+			  return fpForestInfo.returnImageWidth();
+			}
+
+			inline int returnPatchHeightMax(){
+			  return fpForestInfo.returnPatchHeightMax();
+			}
+
+			inline int returnPatchHeightMin(){
+			  return fpForestInfo.returnPatchHeightMin();
+			}
+
+			inline int returnPatchWidthMax(){
+			  return fpForestInfo.returnPatchWidthMax();
+			}
+
+			inline int returnPatchWidthMin(){
+			  return fpForestInfo.returnPatchWidthMin();
+			}
+
+
+	}; // class fpContext
+
+} //namespace fp
+#endif //fpContext.h
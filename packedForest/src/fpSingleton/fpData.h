@@ -2,8 +2,10 @@
 #define fpData_h
 
 #include "dataset/inputCSVData.h"
+#include "dataset/inputBinaryData.h"
 #include "dataset/inputMatrixDataColMajor.h"
 #include "dataset/inputMatrixDataRowMajor.h"
+#include "dataset/dataAccessors.h"
 #include "fpInfo.h"
 #include <string>
 #include <vector>
@@ -20,13 +22,28 @@ namespace fp {
 	 * TODO: This is not a good way to do this.  There is nothing different
 	 * from training data and test data.  This is wrong.  test data should 
 	 * be stored by observation whereas training data is stored by feature.
+	 *
+	 * The type features are stored as is chosen when the data is loaded and
+	 * must be the same type used to read it back: a forest of type T loads
+	 * and reads its data as T.  DATA_TYPE_X is the default used when no type
+	 * is given.
 	 */
 
 	class fpData{
 
 		protected:
-			inputData<DATA_TYPE_X, DATA_TYPE_Y>* inData;
-			testData<DATA_TYPE_X, DATA_TYPE_Y>* inTestData;
+			inputDataBase<DATA_TYPE_Y>* inData;
+			testDataBase<DATA_TYPE_Y>* inTestData;
+
+			template <typename X>
+				inline inputData<X, DATA_TYPE_Y>* returnInData(){
+					return static_cast<inputData<X, DATA_TYPE_Y>*>(inData);
+				}
+
+			template <typename X>
+				inline testData<X, DATA_TYPE_Y>* returnInTestData(){
+					return static_cast<testData<X, DATA_TYPE_Y>*>(inTestData);
+				}
 
 		public:
 
@@ -48,9 +65,12 @@ namespace fp {
 				inData->printXValues();
 			}
 
+			template <typename X = DATA_TYPE_X>
 			void fpLoadData(fpInfo& settings){
-				if(settings.loadDataFromCSV()){
-					inData = new inputCSVData<DATA_TYPE_X, DATA_TYPE_Y>(settings.returnCSVFileName(), settings.returnColumnWithY());
+				if(settings.loadDataFromBinary()){
+					inData = new inputBinaryData<X, DATA_TYPE_Y>(settings.returnBinaryFileName());
+				}else if(settings.loadDataFromCSV()){
+					inData = new inputCSVData<X, DATA_TYPE_Y>(settings.returnCSVFileName(), settings.returnColumnWithY(), settings.returnNumThreads());
 				}else {
 					throw std::runtime_error("Unable to read data." );
 				}
@@ -58,11 +78,12 @@ namespace fp {
 			}
 
 
-			void fpLoadData(const DATA_TYPE_X* x, const DATA_TYPE_Y* y,int numObs, int numFeatures,fpInfo& settings){
+			template <typename X>
+			void fpLoadData(const X* x, const DATA_TYPE_Y* y,int numObs, int numFeatures,fpInfo& settings){
 				if(settings.returnUseRowMajor()){
-				inData = new inputMatrixDataRowMajor<DATA_TYPE_X, DATA_TYPE_Y>(x,y,numObs,numFeatures);
+				inData = new inputMatrixDataRowMajor<X, DATA_TYPE_Y>(x,y,numObs,numFeatures);
 				}else{
-				inData = new inputMatrixDataColMajor<DATA_TYPE_X, DATA_TYPE_Y>(x,y,numObs,numFeatures);
+				inData = new inputMatrixDataColMajor<X, DATA_TYPE_Y>(x,y,numObs,numFeatures);
 				}
 				setDataRelatedParameters(settings);
 			}
@@ -95,12 +116,28 @@ namespace fp {
 				return inData->returnClassOfObservation(observationNumber);
 			}
 
-			inline DATA_TYPE_X returnFeatureVal(const int featureNumber, const int observationNumber){
-				return inData->returnFeatureValue(featureNumber, observationNumber);
+			template <typename X = DATA_TYPE_X>
+			inline X returnFeatureVal(const int featureNumber, const int observationNumber){
+				return returnInData<X>()->returnFeatureValue(featureNumber, observationNumber);
 			}
 
+			template <typename X = DATA_TYPE_X>
 			inline void prefetchFeatureVal(const int featureNumber, const int observationNumber){
-				inData->prefetchFeatureValue(featureNumber, observationNumber);
+				returnInData<X>()->prefetchFeatureValue(featureNumber, observationNumber);
+			}
+
+			inline bool dataIsRowMajor(){
+				return inData->isRowMajor();
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline colMajorAccessor<X> returnColMajorAccessor(){
+				return colMajorAccessor<X>(returnInData<X>()->returnXData(), inData->returnNumObservations());
+			}
+
+			template <typename X = DATA_TYPE_X>
+			inline rowMajorAccessor<X> returnRowMajorAccessor(){
+				return rowMajorAccessor<X>(returnInData<X>()->returnXData(), inData->returnNumFeatures());
 			}
 
 
@@ -120,9 +157,10 @@ namespace fp {
 				settings.setNumObservations(this->returnNumTestObservations());
 			}
 
+			template <typename X = DATA_TYPE_X>
 			void fpLoadTestData(fpInfo& settings){
 				if(settings.loadDataFromCSV()){
-					inTestData = new testData<DATA_TYPE_X, DATA_TYPE_Y>(settings.returnCSVFileName(), settings.returnColumnWithY());
+					inTestData = new testData<X, DATA_TYPE_Y>(settings.returnCSVFileName(), settings.returnColumnWithY(), settings.returnNumThreads());
 				}else {
 					throw std::runtime_error("Unable to read test data." );
 				}
@@ -143,8 +181,9 @@ namespace fp {
 			inline int returnTestLabel(int observationNumber){
 				return inTestData->returnClassOfObservation(observationNumber);
 			}
-			inline DATA_TYPE_X returnTestFeatureVal(const int featureNumber, const int observationNumber){
-				return inTestData->returnFeatureValue(featureNumber, observationNumber);
+			template <typename X = DATA_TYPE_X>
+			inline X returnTestFeatureVal(const int featureNumber, const int observationNumber){
+				return returnInTestData<X>()->returnFeatureValue(featureNumber, observationNumber);
 			}
 	}; // class fpData
 } //namespace fp
@@ -50,6 +50,7 @@ namespace fp {
 
 			std::string forestType;
 			std::string CSVFileName;
+			std::string binaryFileName;
 
 			int seed;
 			randomNumberRerFMWC randNum;
@@ -57,6 +58,43 @@ namespace fp {
 			int numTreeBins;
 			bool useRowMajor;
 
+			//0 uses exact sorted splits, otherwise the number of histogram
+			//bins binned nodes bucket candidate values into.
+			int numHistogramBins;
+
+			//how binned nodes sort candidate values: 0 picks by node size,
+			//1 always uses pdqsort, 2 always uses radix sort.
+			int sortStrategy;
+
+			//grow binned trees as OpenMP tasks so threads are not limited
+			//to one bin each.
+			bool useNodeTasks;
+
+			//evaluate the candidates of large binned nodes in parallel.
+			bool useFeatureTasks;
+
+			//1 bootstraps every binned tree, less than 1 grows each tree on
+			//this fraction of the observations sampled without replacement.
+			double sampleFraction;
+
+			//structured RerF projects patches from per observation summed
+			//area tables instead of summing their pixels.
+			bool useSummedAreaTables;
+
+			//binned forests tally the votes of out of bag observations.
+			bool computeOOB;
+
+			//observations whose trees binned batch prediction advances
+			//together, to overlap their memory loads.  Worth raising when
+			//the forest is far larger than the cache and bins hold few
+			//trees.
+			int predictGroupSize;
+
+			//binned forests lay their nodes out by how often the training
+			//observations visit them, the top depthIntertwined levels of a
+			//bin's trees interleaved.  -1 keeps the nodes in creation order.
+			int depthIntertwined;
+
 
 		public:
 
@@ -77,6 +115,15 @@ namespace fp {
 				numCores=1;
 				seed=-1;
 				numTreeBins=-1;
+				numHistogramBins=0;
+				sortStrategy=0;
+				useNodeTasks=false;
+				useFeatureTasks=false;
+				sampleFraction=1.0;
+				useSummedAreaTables=false;
+				computeOOB=false;
+				predictGroupSize=1;
+				depthIntertwined=-1;
 				methodToUse = 1; // Should this default to 1?
 				imageHeight = 0;
 				imageWidth = 0;
@@ -86,6 +133,7 @@ namespace fp {
 				patchWidthMax = 0;
 				forestType.clear();
 				CSVFileName.clear();
+				binaryFileName.clear();
 				//initRandom();
 			}
 
@@ -98,6 +146,42 @@ namespace fp {
 				numTreeBins = numTB;
 			}
 
+			inline int returnNumHistogramBins(){
+				return numHistogramBins;
+			}
+
+			inline int returnSortStrategy(){
+				return sortStrategy;
+			}
+
+			inline bool returnUseNodeTasks(){
+				return useNodeTasks;
+			}
+
+			inline bool returnUseFeatureTasks(){
+				return useFeatureTasks;
+			}
+
+			inline double returnSampleFraction(){
+				return sampleFraction;
+			}
+
+			inline bool returnUseSummedAreaTables(){
+				return useSummedAreaTables;
+			}
+
+			inline bool returnComputeOOB(){
+				return computeOOB;
+			}
+
+			inline int returnPredictGroupSize(){
+				return predictGroupSize;
+			}
+
+			inline int returnDepthIntertwined(){
+				return depthIntertwined;
+			}
+
 			inline bool returnUseBinning(){
 				return binMin;
 			}
@@ -114,6 +198,10 @@ namespace fp {
 				return CSVFileName;
 			}
 
+			inline std::string& returnBinaryFileName(){
+				return binaryFileName;
+			}
+
 			inline std::string& returnForestType(){
 				return forestType;
 			}
@@ -167,6 +255,10 @@ namespace fp {
 				return false;
 			}
 
+			inline bool loadDataFromBinary(){
+				return !binaryFileName.empty();
+			}
+
 			inline int returnMtry(){
 				return mtry;
 			}
@@ -243,7 +335,7 @@ namespace fp {
 			minParent(1),	numClasses(-1), numObservations(-1), numFeatures(-1),
 			mtry(-1),mtryMult(1), columnWithY(-1),
 			methodToUse(1), imageHeight(0), imageWidth(0), patchHeightMin(0), patchHeightMax(0), patchWidthMin(0), patchWidthMax(0),
-			numberOfNodes(0), maxDepth(std::numeric_limits<int>::max()),sumLeafNodeDepths(0), fractionOfFeaturesToTest(-1.0), binSize(0),binMin(0),numCores(1),seed(-1),numTreeBins(-1),  useRowMajor(true){}
+			numberOfNodes(0), maxDepth(std::numeric_limits<int>::max()),sumLeafNodeDepths(0), fractionOfFeaturesToTest(-1.0), binSize(0),binMin(0),numCores(1),seed(-1),numTreeBins(-1),  useRowMajor(true), numHistogramBins(0), sortStrategy(0), useNodeTasks(false), useFeatureTasks(false), sampleFraction(1.0), useSummedAreaTables(false), computeOOB(false), predictGroupSize(1), depthIntertwined(-1){}
 
 
 
@@ -252,6 +344,8 @@ namespace fp {
 					forestType = parameterValue;
 				}else if(parameterName == "CSVFileName"){
 					CSVFileName = parameterValue;
+				}else if(parameterName == "binaryFileName"){
+					binaryFileName = parameterValue;
 				}else{
 					throw std::runtime_error("Unknown parameter type.(string)");
 				}
@@ -287,6 +381,21 @@ namespace fp {
 					numTreeBins = (int)parameterValue;
 				}else if(parameterName == "useRowMajor"){
 					useRowMajor = (bool)parameterValue;
+				}else if(parameterName == "useNodeTasks"){
+					useNodeTasks = (bool)parameterValue;
+				}else if(parameterName == "useFeatureTasks"){
+					useFeatureTasks = (bool)parameterValue;
+				}else if(parameterName == "useSummedAreaTables"){
+					useSummedAreaTables = (bool)parameterValue;
+				}else if(parameterName == "computeOOB"){
+					computeOOB = (bool)parameterValue;
+				}else if(parameterName == "sampleFraction"){
+					sampleFraction = parameterValue;
+					if(!(sampleFraction > 0.0 && sampleFraction <= 1.0)){
+						throw std::runtime_error("sampleFraction must be in (0,1].");
+					}
+				}else if(parameterName == "numHistogramBins" || parameterName == "sortStrategy" || parameterName == "predictGroupSize" || parameterName == "depthIntertwined"){
+					setParameter(parameterName, (int)parameterValue);
 				}else {
 					throw std::runtime_error("Unknown parameter type.(double)");
 				}
@@ -322,6 +431,36 @@ namespace fp {
 					numTreeBins = parameterValue;
 				}else if(parameterName == "useRowMajor"){
 					useRowMajor = (bool)parameterValue;
+				}else if(parameterName == "useNodeTasks"){
+					useNodeTasks = (bool)parameterValue;
+				}else if(parameterName == "useFeatureTasks"){
+					useFeatureTasks = (bool)parameterValue;
+				}else if(parameterName == "useSummedAreaTables"){
+					useSummedAreaTables = (bool)parameterValue;
+				}else if(parameterName == "computeOOB"){
+					computeOOB = (bool)parameterValue;
+				}else if(parameterName == "sampleFraction"){
+					setParameter(parameterName, (double)parameterValue);
+				}else if(parameterName == "numHistogramBins"){
+					numHistogramBins = parameterValue;
+					if(numHistogramBins < 0 || numHistogramBins == 1){
+						throw std::runtime_error("numHistogramBins must be 0 (exact splits) or at least 2.");
+					}
+				}else if(parameterName == "sortStrategy"){
+					sortStrategy = parameterValue;
+					if(sortStrategy < 0 || sortStrategy > 2){
+						throw std::runtime_error("sortStrategy outside allowable parameters {0,1,2}.");
+					}
+				}else if(parameterName == "predictGroupSize"){
+					predictGroupSize = parameterValue;
+					if(predictGroupSize < 1){
+						throw std::runtime_error("predictGroupSize must be at least 1.");
+					}
+				}else if(parameterName == "depthIntertwined"){
+					depthIntertwined = parameterValue;
+					if(depthIntertwined < -1){
+						throw std::runtime_error("depthIntertwined must be -1 (creation order) or at least 0.");
+					}
 				}else if(parameterName == "methodToUse"){
 					methodToUse = parameterValue;
 					if(!(methodToUse == 1 || methodToUse == 2)){
@@ -355,6 +494,9 @@ namespace fp {
 				std::cout << "mtryMult -> " << mtryMult << "\n";
 				std::cout << "fractionOfFeaturesToTest -> " << fractionOfFeaturesToTest << "\n";
 				std::cout << "CSV file name -> " <<  CSVFileName << "\n";
+				if(!binaryFileName.empty()){
+					std::cout << "binary file name -> " <<  binaryFileName << "\n";
+				}
 				std::cout << "columnWithY -> " << columnWithY << "\n";
 				std::cout << "Type of Forest -> " << forestType << "\n";
 				std::cout << "binSize -> " << binSize << "\n";
@@ -362,6 +504,33 @@ namespace fp {
 				std::cout << "numCores -> " << numCores << "\n";
 				std::cout << "seed -> " << seed << "\n";
 				std::cout << "numTreeBins -> " << numTreeBins << "\n";
+				if(useNodeTasks){
+					std::cout << "useNodeTasks -> " << useNodeTasks << "\n";
+				}
+				if(useFeatureTasks){
+					std::cout << "useFeatureTasks -> " << useFeatureTasks << "\n";
+				}
+				if(sortStrategy){
+					std::cout << "sortStrategy -> " << sortStrategy << "\n";
+				}
+				if(numHistogramBins){
+					std::cout << "numHistogramBins -> " << numHistogramBins << "\n";
+				}
+				if(sampleFraction < 1.0){
+					std::cout << "sampleFraction -> " << sampleFraction << "\n";
+				}
+				if(useSummedAreaTables){
+					std::cout << "useSummedAreaTables -> " << useSummedAreaTables << "\n";
+				}
+				if(computeOOB){
+					std::cout << "computeOOB -> " << computeOOB << "\n";
+				}
+				if(predictGroupSize > 1){
+					std::cout << "predictGroupSize -> " << predictGroupSize << "\n";
+				}
+				if(depthIntertwined >= 0){
+					std::cout << "depthIntertwined -> " << depthIntertwined << "\n";
+				}
 
 				if(methodToUse == 2){
 					std::cout << "imageHeight -> " << imageHeight << "\n";
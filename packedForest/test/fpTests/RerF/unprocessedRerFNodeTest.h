@@ -6,7 +6,7 @@ using namespace fp;
 TEST(checkunprocessedRerFNode, basicSetTests )
 {
 int numObjects = 150;
-baseUnprocessedNode<float> testNode(numObjects);
+baseUnprocessedNode<float> testNode(fpSingleton::getSingleton(), numObjects);
 
 	EXPECT_TRUE(testNode.returnIsLeftNode());
 	EXPECT_EQ(testNode.returnInSampleSize(), numObjects);
@@ -16,7 +16,7 @@ baseUnprocessedNode<float> testNode(numObjects);
 TEST(checkunprocessedRerFNode, transferIndices )
 {
 int numObjects = 150;
-baseUnprocessedNode<float> testNode(numObjects);
+baseUnprocessedNode<float> testNode(fpSingleton::getSingleton(), numObjects);
 
 	EXPECT_TRUE(testNode.returnIsLeftNode());
 	EXPECT_EQ(testNode.returnInSampleSize(), numObjects);
@@ -9,7 +9,7 @@ using namespace fp;
 TEST(checkBaseUnprocessedNode, basicSetTests )
 {
 int numObjects = 150;
-baseUnprocessedNode<double> testNode(numObjects);
+baseUnprocessedNode<double> testNode(fpSingleton::getSingleton(), numObjects);
 
 	EXPECT_TRUE(testNode.returnIsLeftNode());
 	EXPECT_EQ(testNode.returnInSampleSize(), numObjects);
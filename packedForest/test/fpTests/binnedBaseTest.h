@@ -9,14 +9,17 @@ TEST(testBinnedBase, testBaseMaxDepth){
   fpSingleton::getSingleton().setParameter("minParent", 1);
   fpSingleton::getSingleton().setParameter("numCores", 1);
   fpSingleton::getSingleton().setParameter("seed",-1661580697);
+  fpSingleton::getSingleton().loadData();
+  fpSingleton::getSingleton().setDataDependentParameters();
   
   for(int setDepth = 1; setDepth < 10; ++setDepth){
     fpSingleton::getSingleton().setParameter("maxDepth", setDepth);
-    fp::binnedBase<double, int> forest;
+    fp::binnedBase<double, int> forest(fpSingleton::getSingleton());
     forest.growForest();
     std::map<std::string, int> stats = forest.calcBinStats();
     EXPECT_LE(stats["maxDepth"], setDepth);
   }
+  fpSingleton::getSingleton().deleteData();
 }
 
 TEST(testBinnedBase, testRerFMaxDepth){
@@ -26,12 +29,15 @@ TEST(testBinnedBase, testRerFMaxDepth){
   fpSingleton::getSingleton().setParameter("minParent", 1);
   fpSingleton::getSingleton().setParameter("numCores", 1);
   fpSingleton::getSingleton().setParameter("seed",-1661580697);
+  fpSingleton::getSingleton().loadData();
+  fpSingleton::getSingleton().setDataDependentParameters();
   
   for(int setDepth = 1; setDepth < 10; ++setDepth){
     fpSingleton::getSingleton().setParameter("maxDepth", setDepth);
-    fp::binnedBase<double, std::vector<int>> forest;
+    fp::binnedBase<double, std::vector<int>> forest(fpSingleton::getSingleton());
     forest.growForest();
     std::map<std::string, int> stats = forest.calcBinStats();
     EXPECT_LE(stats["maxDepth"], setDepth);
   }
+  fpSingleton::getSingleton().deleteData();
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "../../../src/forestTypes/binnedTree/packedBin.h"
+#include "../../../src/fpSingleton/fpSingleton.h"
+
+#include <vector>
+
+using namespace fp;
+
+class singletonAccessor
+{
+	public:
+		inline double returnFeatureValue(const int featureNum, const int observationNum) const{
+			return fpSingleton::getSingleton().returnFeatureVal<double>(featureNum, observationNum);
+		}
+};
+
+inline double projectGrownNode(int feature, int obs){
+	return fpSingleton::getSingleton().returnFeatureVal<double>(feature, obs);
+}
+
+inline double projectGrownNode(std::vector<int>& features, int obs){
+	double featureVal = 0;
+	for(auto feature : features){
+		featureVal += fpSingleton::getSingleton().returnFeatureVal<double>(feature, obs);
+	}
+	return featureVal;
+}
+
+inline double projectGrownNode(weightedFeature& features, int obs){
+	double featureVal = 0;
+	for(int i = 0; i < (int)features.returnFeatures().size(); ++i){
+		featureVal += fpSingleton::getSingleton().returnFeatureVal<double>(features.returnFeatures()[i], obs)*features.returnWeights()[i];
+	}
+	return featureVal;
+}
+
+//every training observation gets the same votes from the packed bin as
+//from the nodes it was packed from, compared at float precision.  The
+//packed bin is reordered first unless depthIntertwined is -1.
+template <typename Q>
+void expectPackedBinMatchesGrownBin(int depthIntertwined = -1){
+	fpSingleton::getSingleton().setParameter("CSVFileName", "../res/iris.csv");
+	fpSingleton::getSingleton().setParameter("columnWithY", 4);
+	fpSingleton::getSingleton().setParameter("maxDepth", std::numeric_limits<int>::max());
+	fpSingleton::getSingleton().setParameter("methodToUse", 1);
+	fpSingleton::getSingleton().setParameter("useSummedAreaTables", 0);
+	fpSingleton::getSingleton().setParameter("seed",-1661580697);
+	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().setDataDependentParameters();
+
+	const int numClasses = fpSingleton::getSingleton().returnNumClasses();
+	const int numTrees = 5;
+	binStruct<double, Q> bin(fpSingleton::getSingleton());
+	bin.createBin(numTrees, 7);
+	packedBin<double, Q> packed(bin, numClasses);
+	EXPECT_EQ(packed.returnNumTrees(), numTrees);
+	if(depthIntertwined >= 0){
+		packed.reorderNodes(singletonAccessor(), fpSingleton::getSingleton().returnNumObservations(), depthIntertwined);
+	}
+
+	std::vector<fpBaseNode<double, Q> >& nodes = bin.returnNodes();
+	for(int obs = 0; obs < fpSingleton::getSingleton().returnNumObservations(); ++obs){
+		std::vector<int> grownVotes(numClasses, 0);
+		for(int tree = 0; tree < numTrees; ++tree){
+			int node = tree+numClasses;
+			while(nodes[node].isInternalNodeFront()){
+				//packed cut values are floats.
+				if((float)projectGrownNode(nodes[node].returnFeatureNumber(), obs) <= (float)nodes[node].returnCutValue()){
+					node = nodes[node].returnLeftNodeID();
+				}else{
+					node = nodes[node].returnRightNodeID();
+				}
+			}
+			++grownVotes[nodes[node].returnClass()];
+		}
+
+		std::vector<int> packedVotes(numClasses, 0);
+		packed.predictObservation(singletonAccessor(), obs, packedVotes.data());
+		EXPECT_EQ(grownVotes, packedVotes);
+
+		std::vector<int> tileVotes(numClasses, 0);
+		packed.predictTile(singletonAccessor(), obs, 1, 3, tileVotes.data());
+		EXPECT_EQ(grownVotes, tileVotes);
+	}
+}
+
+TEST(packedBinTest, nodesAreSixteenBytes)
+{
+	EXPECT_EQ(sizeof(packedNode), 16);
+}
+
+TEST(packedBinTest, packedBinMatchesGrownBin)
+{
+	expectPackedBinMatchesGrownBin<int>();
+}
+
+TEST(packedBinTest, packedBinMatchesGrownBinRerF)
+{
+	expectPackedBinMatchesGrownBin<std::vector<int> >();
+}
+
+TEST(packedBinTest, packedBinMatchesGrownBinTern)
+{
+	expectPackedBinMatchesGrownBin<weightedFeature>();
+}
+
+TEST(packedBinTest, reorderedBinMatchesGrownBin)
+{
+	expectPackedBinMatchesGrownBin<int>(2);
+}
+
+TEST(packedBinTest, reorderedBinMatchesGrownBinRerF)
+{
+	expectPackedBinMatchesGrownBin<std::vector<int> >(0);
+}
+
+TEST(packedBinTest, reorderedBinMatchesGrownBinTern)
+{
+	expectPackedBinMatchesGrownBin<weightedFeature>(3);
+}
+
+//below the interleaved levels the more visited internal child of a node
+//is the node after it.
+TEST(packedBinTest, reorderedBinPlacesHotChildNext)
+{
+	fpSingleton::getSingleton().setParameter("CSVFileName", "../res/iris.csv");
+	fpSingleton::getSingleton().setParameter("columnWithY", 4);
+	fpSingleton::getSingleton().setParameter("maxDepth", std::numeric_limits<int>::max());
+	fpSingleton::getSingleton().setParameter("methodToUse", 1);
+	fpSingleton::getSingleton().setParameter("useSummedAreaTables", 0);
+	fpSingleton::getSingleton().setParameter("seed",-1661580697);
+	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().setDataDependentParameters();
+
+	const int numObservations = fpSingleton::getSingleton().returnNumObservations();
+	const int numTrees = 5;
+	const int depthIntertwined = 2;
+	binStruct<double, std::vector<int> > bin(fpSingleton::getSingleton());
+	bin.createBin(numTrees, 7);
+	packedBin<double, std::vector<int> > packed(bin, fpSingleton::getSingleton().returnNumClasses());
+	packed.reorderNodes(singletonAccessor(), numObservations, depthIntertwined);
+
+	const packedNode* nodes = packed.returnNodes();
+	const std::vector<int> visits = packed.returnNodeVisits(singletonAccessor(), numObservations);
+	std::vector<int> depths(packed.returnNumNodes(), -1);
+	int numInternalRoots = 0;
+	for(int tree = 0; tree < numTrees; ++tree){
+		const int root = packed.returnRoots()[tree];
+		if(root >= 0){
+			EXPECT_EQ(root, numInternalRoots++);
+			depths[root] = 0;
+		}
+	}
+
+	for(int position = 0; position < packed.returnNumNodes(); ++position){
+		ASSERT_GE(depths[position], 0);
+		const packedNode& node = nodes[position];
+		if(node.left >= 0){
+			depths[node.left] = depths[position]+1;
+		}
+		if(node.right >= 0){
+			depths[node.right] = depths[position]+1;
+		}
+		if(depths[position] < depthIntertwined || (node.left < 0 && node.right < 0)){
+			continue;
+		}
+		int hotChild = node.left;
+		if(node.right >= 0 && (node.left < 0 || visits[node.right] > visits[node.left])){
+			hotChild = node.right;
+		}
+		EXPECT_EQ(hotChild, position+1);
+	}
+}
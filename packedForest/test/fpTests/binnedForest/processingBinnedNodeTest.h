@@ -24,7 +24,7 @@ TEST(processingBinnedNodeTest, checkWeightedMtry)
 
 	std::vector<weightedFeature> wf;
 	randomNumberRerFMWC randNumGen;
-	processingNodeBin<double, weightedFeature> pNB(1,1,1,randNumGen);
+	processingNodeBin<double, weightedFeature> pNB(1,1,1,randNumGen, fpSingleton::getSingleton());
 
 	pNB.calcMtryForNodeTest(wf);
 	EXPECT_EQ((int)wf.size(),fpSingleton::getSingleton().returnMtry());
@@ -27,7 +27,7 @@ TEST(processingNodeBinTest, checkWeightedMtry)
 
 	std::vector<weightedFeature> wf;
 	randomNumberRerFMWC randNumGen;
-	processingNodeBin<double, weightedFeature> pNB(1, 1, 1, randNumGen);
+	processingNodeBin<double, weightedFeature> pNB(1, 1, 1, randNumGen, fpSingleton::getSingleton());
 
 	pNB.calcMtryForNodeTest(wf);
 	EXPECT_EQ((int)wf.size(), fpSingleton::getSingleton().returnMtry());
@@ -64,7 +64,7 @@ TEST(testProcessingNodeBin, testMtryMult)
 	int seed = rd();
 	randNum.initialize(seed);
 
-	processingNodeBin<double, std::vector<int>> pNodeBin(treeNum, nodeNum, depth, randNum);
+	processingNodeBin<double, std::vector<int>> pNodeBin(treeNum, nodeNum, depth, randNum, fpSingleton::getSingleton());
 
 	for (double setMtryMult = 1; setMtryMult < 4; setMtryMult += 0.5)
 	{
@@ -126,7 +126,7 @@ TEST(processingNodeBinTest, checkStructuredRerF_2d)
 
 	std::vector<weightedFeature> wf;
 	randomNumberRerFMWC randNumGen;
-	processingNodeBin<double, weightedFeature> procNB(1, 1, 1, randNumGen);
+	processingNodeBin<double, weightedFeature> procNB(1, 1, 1, randNumGen, fpSingleton::getSingleton());
 
 	// Get the 28x28 patch at the top left and make sure we don't fall
 	// off the edge.
@@ -177,7 +177,7 @@ TEST(processingNodeBinTest, paramRandMatImagePatch_Test)
 
 	std::vector<weightedFeature> wf;
 	randomNumberRerFMWC randNumGen;
-	processingNodeBin<double, weightedFeature> pNB(1, 1, 1, randNumGen);
+	processingNodeBin<double, weightedFeature> pNB(1, 1, 1, randNumGen, fpSingleton::getSingleton());
 
 	// Get the 28x28 patch at the top left and make sure we don't fall
 	// off the edge.
@@ -199,7 +199,7 @@ TEST(processingNodeBinTest, paramRandMatImagePatch_Test)
 
 	std::vector<weightedFeature> wfA;
 	randomNumberRerFMWC randNumGenA;
-	processingNodeBin<double, weightedFeature> pNBA(1, 1, 1, randNumGenA);
+	processingNodeBin<double, weightedFeature> pNBA(1, 1, 1, randNumGenA, fpSingleton::getSingleton());
 
 	wfA.resize(fpSingleton::getSingleton().returnMtry());
 	std::vector<std::vector<int> > testVecA = pNBA.paramsRandMatImagePatchTest();
@@ -267,3 +267,81 @@ TEST(processingNodeBinTest, paramRandMatImagePatch_Test)
 		}
 	}
 }
+
+
+TEST(processingNodeBinTest, sparseProjectionMatchesWeightedSum)
+{
+	const int numObs = 7;
+	const int numFeatures = 3;
+	std::vector<float> rowMajor(numObs*numFeatures);
+	std::vector<float> colMajor(numObs*numFeatures);
+	for(int i = 0; i < numObs; ++i){
+		for(int j = 0; j < numFeatures; ++j){
+			rowMajor[i*numFeatures+j] = colMajor[j*numObs+i] = (float)(i*numFeatures+j);
+		}
+	}
+
+	weightedFeature wf;
+	wf.returnFeatures() = {2, 0, 1, 2};
+	wf.returnWeights() = {1, -1, 0.5, -1};
+
+	std::vector<obsIndex> obs = {6, 1, 3, 4};
+	std::vector<float> rowValues(obs.size());
+	std::vector<float> colValues(obs.size());
+
+	sparseProjection<float> projection;
+	projection.setProjection(wf);
+	projection.project(rowMajorAccessor<float>(rowMajor.data(), numFeatures), obs.data(), obs.size(), rowValues.data());
+	projection.project(colMajorAccessor<float>(colMajor.data(), numObs), obs.data(), obs.size(), colValues.data());
+
+	for(unsigned int k = 0; k < obs.size(); ++k){
+		float expected = 0;
+		for(unsigned int f = 0; f < wf.returnFeatures().size(); ++f){
+			expected += rowMajor[obs[k]*numFeatures + wf.returnFeatures()[f]]*wf.returnWeights()[f];
+		}
+		EXPECT_FLOAT_EQ(expected, rowValues[k]);
+		EXPECT_FLOAT_EQ(expected, colValues[k]);
+	}
+
+	projection.setProjection(std::vector<int>{1, 1});
+	projection.project(rowMajorAccessor<float>(rowMajor.data(), numFeatures), obs.data(), obs.size(), rowValues.data());
+	EXPECT_FLOAT_EQ(2*rowMajor[obs[0]*numFeatures+1], rowValues[0]);
+}
+
+
+TEST(processingNodeBinTest, summedAreaTablePatchesMatchPixelSums)
+{
+	const int imageHeight = 4;
+	const int imageWidth = 5;
+	std::vector<float> image(imageHeight*imageWidth);
+	for(unsigned int i = 0; i < image.size(); ++i){
+		image[i] = (float)((i*7)%11);
+	}
+
+	std::vector<float> table(summedAreaTable::returnTableSize(imageHeight, imageWidth));
+	summedAreaTable::buildTable([&](int pixel){return image[pixel];}, imageHeight, imageWidth, table.data());
+
+	for(int top = 0; top < imageHeight; ++top){
+		for(int left = 0; left < imageWidth; ++left){
+			for(int height = 1; top+height <= imageHeight; ++height){
+				for(int width = 1; left+width <= imageWidth; ++width){
+					float pixelSum = 0;
+					for(int row = top; row < top+height; ++row){
+						for(int col = left; col < left+width; ++col){
+							pixelSum += image[row*imageWidth+col];
+						}
+					}
+
+					weightedFeature patch;
+					summedAreaTable::setPatch(patch, top*imageWidth+left, height, width, imageWidth);
+					ASSERT_EQ(4, (int)patch.returnFeatures().size());
+					float tableSum = 0;
+					for(int k = 0; k < 4; ++k){
+						tableSum += table[patch.returnFeatures()[k]]*patch.returnWeights()[k];
+					}
+					EXPECT_FLOAT_EQ(pixelSum, tableSum);
+				}
+			}
+		}
+	}
+}
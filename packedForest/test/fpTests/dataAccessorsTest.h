@@ -0,0 +1,34 @@
+#include "../../src/fpSingleton/dataset/inputCSVData.h"
+#include "../../src/fpSingleton/dataset/inputMatrixDataRowMajor.h"
+#include "../../src/fpSingleton/dataset/dataAccessors.h"
+
+using namespace fp;
+
+TEST(dataAccessors, accessorsMatchReturnFeatureValue)
+{
+	inputCSVData<double,int> csvData("./res/testCSVAllClass.csv", 0);
+	const int numObs = csvData.returnNumObservations();
+	const int numFeatures = csvData.returnNumFeatures();
+
+	std::vector<double> rowMajorX(numObs*numFeatures);
+	std::vector<int> labels(numObs);
+	for(int obs = 0; obs < numObs; ++obs){
+		labels[obs] = csvData.returnClassOfObservation(obs);
+		for(int feature = 0; feature < numFeatures; ++feature){
+			rowMajorX[obs*numFeatures + feature] = csvData.returnFeatureValue(feature, obs);
+		}
+	}
+	inputMatrixDataRowMajor<double,int> rowData(rowMajorX.data(), labels.data(), numObs, numFeatures);
+
+	EXPECT_FALSE(csvData.isRowMajor());
+	EXPECT_TRUE(rowData.isRowMajor());
+
+	colMajorAccessor<double> colAccess(csvData.returnXData(), numObs);
+	rowMajorAccessor<double> rowAccess(rowData.returnXData(), numFeatures);
+	for(int obs = 0; obs < numObs; ++obs){
+		for(int feature = 0; feature < numFeatures; ++feature){
+			EXPECT_EQ(csvData.returnFeatureValue(feature, obs), colAccess.returnFeatureValue(feature, obs));
+			EXPECT_EQ(csvData.returnFeatureValue(feature, obs), rowAccess.returnFeatureValue(feature, obs));
+		}
+	}
+}
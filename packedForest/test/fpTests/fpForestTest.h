@@ -1,6 +1,46 @@
 // This tests whether the seed works in single/parallel execution
 
 #include "../../src/packedForest.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+// Row major normal features labelled X0 + X1*X2 > 0, optionally also
+// copied column major.
+static void makeSyntheticData(const int numObs, const int numFeatures, const int seed, std::vector<double>& X, std::vector<int>& Y, std::vector<double>* colMajorX = NULL)
+{
+	std::mt19937 eng(seed);
+	std::normal_distribution<double> dist;
+	X.resize(numObs*numFeatures);
+	Y.resize(numObs);
+	if(colMajorX != NULL){
+		colMajorX->resize(numObs*numFeatures);
+	}
+	for(int i = 0; i < numObs; ++i){
+		for(int j = 0; j < numFeatures; ++j){
+			X[i*numFeatures+j] = dist(eng);
+			if(colMajorX != NULL){
+				(*colMajorX)[j*numObs+i] = X[i*numFeatures+j];
+			}
+		}
+		Y[i] = X[i*numFeatures] + X[i*numFeatures+1]*X[i*numFeatures+2] > 0;
+	}
+}
+
+// Structured RerF on imageHeight x imageWidth images with patches of one or
+// two pixels a side, using summed area tables.
+static void setSummedAreaTableParameters(fp::fpForest<double>& forest, const int imageHeight, const int imageWidth)
+{
+	forest.setParameter("methodToUse", 2);
+	forest.setParameter("imageHeight", imageHeight);
+	forest.setParameter("imageWidth", imageWidth);
+	forest.setParameter("patchHeightMin", 1);
+	forest.setParameter("patchHeightMax", 2);
+	forest.setParameter("patchWidthMin", 1);
+	forest.setParameter("patchWidthMax", 2);
+	forest.setParameter("useSummedAreaTables", 1);
+}
 
 TEST(testAUCReturn, AUCReturnBinnedBase)
 {
@@ -46,6 +86,287 @@ TEST(testAUCReturn, AUCReturnBinnedBaseRerF)
 	EXPECT_EQ(results[2], 0);
 }
 
+TEST(testAUCReturn, AUCReturnBinnedBaseRerFHistogram)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBaseRerF");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("numHistogramBins", 4);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<double> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+	EXPECT_EQ(results[1], 0);
+	EXPECT_EQ(results[2], 0);
+	EXPECT_LT(forest.testAccuracy(), 0.1);
+}
+
+TEST(testAUCReturn, AUCReturnBinnedBaseRerFSubsample)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBaseRerF");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("sampleFraction", 0.5);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<double> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+	EXPECT_LT(forest.testAccuracy(), 0.1);
+}
+
+TEST(testAUCReturn, AUCReturnBinnedBaseTernSummedAreaTables)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBaseTern");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	setSummedAreaTableParameters(forest, 2, 2);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<double> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+	EXPECT_LT(forest.testAccuracy(), 0.1);
+}
+
+TEST(testAUCReturn, OOBBinnedForests)
+{
+	for(auto forestType : {"binnedBase", "binnedBaseRerF", "binnedBaseTern"}){
+		for(double sampleFraction : {1.0, 0.5}){
+			fp::fpForest<double> forest;
+			forest.setParameter("forestType", forestType);
+			forest.setParameter("CSVFileName", "../res/iris.csv");
+			forest.setParameter("columnWithY", 4);
+			forest.setParameter("numTreesInForest", 20);
+			forest.setParameter("minParent", 1);
+			forest.setParameter("numCores", 1);
+			forest.setParameter("sampleFraction", sampleFraction);
+			forest.setParameter("computeOOB", 1);
+			forest.setParameter("seed",-1661580697);
+			forest.growForest();
+
+			EXPECT_GT(forest.reportOOB(), 0.85);
+			EXPECT_LE(forest.reportOOB(), 1.0);
+		}
+	}
+}
+
+TEST(testAUCReturn, OOBIndependentOfNumCores)
+{
+	const int numObs = 5000;
+	const int numFeatures = 4;
+	std::vector<double> X;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 17, X, Y);
+
+	for(int useNodeTasks : {0, 1}){
+		std::vector<float> OOBAccuracies;
+		for(int numCores : {1, 4}){
+			fp::fpForest<double> forest;
+			forest.setParameter("forestType", "binnedBase");
+			forest.setParameter("numTreesInForest", 12);
+			forest.setParameter("numTreeBins", 6);
+			forest.setParameter("numCores", numCores);
+			forest.setParameter("useNodeTasks", useNodeTasks);
+			forest.setParameter("computeOOB", 1);
+			forest.setParameter("seed",-1661580697);
+			forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+			OOBAccuracies.push_back(forest.reportOOB());
+		}
+
+		EXPECT_GT(OOBAccuracies[0], 0.8);
+		EXPECT_EQ(OOBAccuracies[0], OOBAccuracies[1]);
+	}
+}
+
+TEST(testAUCReturn, summedAreaTablesOnlyForBinnedBaseTern)
+{
+	for(auto forestType : {"rerf", "binnedBaseRerF", "binnedBase"}){
+		fp::fpForest<double> forest;
+		forest.setParameter("forestType", forestType);
+		forest.setParameter("CSVFileName", "../res/iris.csv");
+		forest.setParameter("columnWithY", 4);
+		setSummedAreaTableParameters(forest, 2, 2);
+		EXPECT_THROW(forest.growForest(), std::runtime_error) << forestType;
+	}
+}
+
+TEST(testAUCReturn, AUCReturnBinnedBaseRerFSortStrategies)
+{
+	for(int sortStrategy = 0; sortStrategy < 3; ++sortStrategy){
+		fp::fpForest<double> forest;
+		forest.setParameter("forestType", "binnedBaseRerF");
+		forest.setParameter("CSVFileName", "../res/iris.csv");
+		forest.setParameter("columnWithY", 4);
+		forest.setParameter("numTreesInForest", 10);
+		forest.setParameter("minParent", 1);
+		forest.setParameter("numCores", 1);
+		forest.setParameter("sortStrategy", sortStrategy);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest();
+
+		std::vector<int> results;
+		std::vector<double> testCase {5.1,3.5,1.4,0.2};
+		results = forest.predictPost(testCase);
+
+		EXPECT_EQ(results.size(), 3);
+		EXPECT_EQ(results[0], 10);
+	}
+}
+
+TEST(testAUCReturn, nodeTasksIndependentOfNumCores)
+{
+	std::vector<std::vector<int> > results;
+	for(int numCores = 1; numCores < 5; numCores += 3){
+		fp::fpForest<double> forest;
+		forest.setParameter("forestType", "binnedBaseRerF");
+		forest.setParameter("CSVFileName", "../res/iris.csv");
+		forest.setParameter("columnWithY", 4);
+		forest.setParameter("numTreesInForest", 10);
+		forest.setParameter("numTreeBins", 2);
+		forest.setParameter("numCores", numCores);
+		forest.setParameter("useNodeTasks", 1);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest();
+
+		std::vector<double> testCase {6.3,2.8,5.1,1.5};
+		results.push_back(forest.predictPost(testCase));
+	}
+
+	EXPECT_EQ(results[0], results[1]);
+	EXPECT_EQ(results[0][0], 0);
+}
+
+TEST(testAUCReturn, featureTasksMatchSerialSplits)
+{
+	//large enough for the root and its children to use feature tasks.
+	const int numObs = 3*globalFeatureTaskMin;
+	const int numFeatures = 8;
+	std::vector<double> X;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 11, X, Y);
+
+	std::vector<std::vector<int> > results;
+	for(int useFeatureTasks = 0; useFeatureTasks < 2; ++useFeatureTasks){
+		fp::fpForest<double> forest;
+		forest.setParameter("forestType", "binnedBaseRerF");
+		forest.setParameter("numTreesInForest", 2);
+		forest.setParameter("numCores", 4);
+		forest.setParameter("maxDepth", 4);
+		forest.setParameter("useFeatureTasks", useFeatureTasks);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+
+		std::vector<int> predictions;
+		for(int i = 0; i < 200; ++i){
+			std::vector<double> observation(X.begin()+i*numFeatures, X.begin()+(i+1)*numFeatures);
+			std::vector<int> votes = forest.predictPost(observation);
+			predictions.insert(predictions.end(), votes.begin(), votes.end());
+		}
+		results.push_back(predictions);
+	}
+
+	EXPECT_EQ(results[0], results[1]);
+}
+
+TEST(testAUCReturn, predictBatchMatchesPredict)
+{
+	const int numObs = 500;
+	const int numFeatures = 8;
+	std::vector<double> X, colMajorX;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 11, X, Y, &colMajorX);
+
+	std::vector<std::string> forestTypes {"rfBase", "rerf", "binnedBase", "binnedBaseRerF", "binnedBaseTern", "summedAreaTables"};
+	for(auto& forestType : forestTypes){
+		fp::fpForest<double> forest;
+		if(forestType == "summedAreaTables"){
+			forest.setParameter("forestType", "binnedBaseTern");
+			setSummedAreaTableParameters(forest, 2, 4);
+		}else{
+			forest.setParameter("forestType", forestType);
+		}
+		forest.setParameter("numTreesInForest", 10);
+		forest.setParameter("numCores", 2);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+
+		std::vector<int> expected(numObs);
+		for(int i = 0; i < numObs; ++i){
+			std::vector<double> observation(X.begin()+i*numFeatures, X.begin()+(i+1)*numFeatures);
+			expected[i] = forest.predict(observation);
+		}
+
+		std::vector<int> predictions(numObs, -1);
+		forest.predictBatch(X.data(), numObs, numFeatures, true, predictions.data());
+		EXPECT_EQ(expected, predictions) << forestType;
+
+		std::fill(predictions.begin(), predictions.end(), -1);
+		forest.predictBatch(colMajorX.data(), numObs, numFeatures, false, predictions.data());
+		EXPECT_EQ(expected, predictions) << forestType;
+
+		EXPECT_THROW(forest.predictBatch(X.data(), numObs, numFeatures-1, true, predictions.data()), std::runtime_error);
+	}
+}
+
+TEST(testAUCReturn, predictBatchIndependentOfGroupSize)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBaseRerF");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("numTreeBins", 3);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	const int numObs = 150;
+	std::vector<double> X;
+	for(int i = 0; i < numObs; ++i){
+		for(int j = 0; j < 4; ++j){
+			X.push_back(0.05*i + j);
+		}
+	}
+
+	std::vector<std::vector<int> > results;
+	for(int groupSize : {1, 3, 8, 64}){
+		forest.setParameter("predictGroupSize", groupSize);
+		std::vector<int> predictions(numObs);
+		forest.predictBatch(X.data(), numObs, 4, true, predictions.data());
+		results.push_back(predictions);
+	}
+	for(auto& predictions : results){
+		EXPECT_EQ(results[0], predictions);
+	}
+}
+
+
 TEST(testAUCReturn, AUCReturnrfBase)
 {
 	fp::fpForest<double> forest;
@@ -89,3 +410,293 @@ TEST(testAUCReturn, AUCReturnrerf)
 	EXPECT_EQ(results[1], 0);
 	EXPECT_EQ(results[2], 0);
 }
+
+TEST(testAUCReturn, AUCReturnBinnedBaseFloat)
+{
+	fp::fpForest<float> forest;
+	forest.setParameter("forestType", "binnedBase");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<float> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+	EXPECT_EQ(results[1], 0);
+	EXPECT_EQ(results[2], 0);
+}
+
+TEST(testAUCReturn, AUCReturnBinnedBaseTernUint8)
+{
+	fp::fpForest<uint8_t> forest;
+	forest.setParameter("forestType", "binnedBaseTern");
+	forest.setParameter("CSVFileName", "../res/irisTimesTen.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<uint8_t> testCase {51,35,14,2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+	EXPECT_EQ(results[1], 0);
+	EXPECT_EQ(results[2], 0);
+}
+
+TEST(testAUCReturn, uint8RejectsUnbinnedForests)
+{
+	fp::fpForest<uint8_t> forest;
+	forest.setParameter("forestType", "rfBase");
+	forest.setParameter("CSVFileName", "../res/irisTimesTen.csv");
+	forest.setParameter("columnWithY", 4);
+	EXPECT_THROW(forest.growForest(), std::runtime_error);
+}
+
+TEST(testAUCReturn, uint8RejectsFractionalValues)
+{
+	fp::fpForest<uint8_t> forest;
+	forest.setParameter("forestType", "binnedBaseTern");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	EXPECT_THROW(forest.growForest(), std::runtime_error);
+}
+
+TEST(testAUCReturn, uint8RejectsOutOfRangeValues)
+{
+	const std::string csvFileName = "../res/uint8OutOfRange.tmp.csv";
+	{
+		std::ofstream csv(csvFileName);
+		csv << "1,2,0\n" << "300,4,1\n" << "5,6,0\n" << "7,-1,1\n";
+	}
+
+	fp::fpForest<uint8_t> forest;
+	forest.setParameter("forestType", "binnedBaseTern");
+	forest.setParameter("CSVFileName", csvFileName);
+	forest.setParameter("columnWithY", 2);
+	forest.setParameter("numTreesInForest", 10);
+	EXPECT_THROW(forest.growForest(), std::runtime_error);
+	std::remove(csvFileName.c_str());
+}
+
+TEST(testAUCReturn, forestsKeepSeparateContexts)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBase");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	{
+		fp::fpForest<float> otherForest;
+		otherForest.setParameter("forestType", "rfBase");
+		otherForest.setParameter("CSVFileName", "../res/iris.csv");
+		otherForest.setParameter("columnWithY", 4);
+		otherForest.setParameter("numTreesInForest", 4);
+		otherForest.setParameter("numCores", 1);
+		otherForest.growForest();
+	}
+
+	std::vector<int> results;
+	std::vector<double> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0], 10);
+}
+
+TEST(testAUCReturn, saveLoadRoundTrip)
+{
+	const std::string forestFileName = "./res/testForest.tmp.fp";
+	const int numObs = 300;
+	const int numFeatures = 8;
+	std::vector<double> X;
+	std::vector<int> Y;
+	makeSyntheticData(numObs, numFeatures, 13, X, Y);
+
+	std::vector<std::string> forestTypes {"rfBase", "rerf", "binnedBase", "binnedBaseRerF", "binnedBaseTern", "summedAreaTables"};
+	for(auto& forestType : forestTypes){
+		fp::fpForest<double> forest;
+		if(forestType == "summedAreaTables"){
+			forest.setParameter("forestType", "binnedBaseTern");
+			setSummedAreaTableParameters(forest, 2, 4);
+		}else{
+			forest.setParameter("forestType", forestType);
+			forest.setParameter("methodToUse", 1);
+		}
+		forest.setParameter("numTreesInForest", 10);
+		forest.setParameter("numTreeBins", 3);
+		forest.setParameter("computeOOB", 1);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest(X.data(), Y.data(), numObs, numFeatures);
+		std::vector<int> expected(numObs);
+		forest.predictBatch(X.data(), numObs, numFeatures, true, expected.data());
+		forest.save(forestFileName);
+
+		fp::fpForest<double> loadedForest;
+		loadedForest.load(forestFileName);
+		std::vector<int> predictions(numObs, -1);
+		loadedForest.predictBatch(X.data(), numObs, numFeatures, true, predictions.data());
+		EXPECT_EQ(expected, predictions) << forestType;
+		for(int i = 0; i < numObs; i += 37){
+			std::vector<double> observation(X.begin()+i*numFeatures, X.begin()+(i+1)*numFeatures);
+			EXPECT_EQ(forest.predictPost(observation), loadedForest.predictPost(observation)) << forestType;
+		}
+		EXPECT_EQ(forest.reportOOB(), loadedForest.reportOOB()) << forestType;
+	}
+	std::remove(forestFileName.c_str());
+}
+
+TEST(testAUCReturn, saveLoadSimilarityPairs)
+{
+	const std::string forestFileName = "./res/testForestUrf.tmp.fp";
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "urf");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 5);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+	forest.save(forestFileName);
+
+	fp::fpForest<double> loadedForest;
+	loadedForest.load(forestFileName);
+	EXPECT_FALSE(forest.returnPairMat().empty());
+	EXPECT_EQ(forest.returnPairMat(), loadedForest.returnPairMat());
+	std::remove(forestFileName.c_str());
+}
+
+TEST(testAUCReturn, loadRejectsOtherFiles)
+{
+	const std::string forestFileName = "./res/testForestBad.tmp.fp";
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBase");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 5);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+	forest.save(forestFileName);
+
+	fp::fpForest<float> floatForest;
+	EXPECT_THROW(floatForest.load(forestFileName), std::runtime_error);
+
+	std::ifstream savedFile(forestFileName, std::ios::binary);
+	std::vector<char> savedBytes((std::istreambuf_iterator<char>(savedFile)), std::istreambuf_iterator<char>());
+	savedFile.close();
+	std::ofstream truncatedFile(forestFileName, std::ios::binary | std::ios::trunc);
+	truncatedFile.write(savedBytes.data(), savedBytes.size()-1);
+	truncatedFile.close();
+	fp::fpForest<double> truncatedForest;
+	EXPECT_THROW(truncatedForest.load(forestFileName), std::runtime_error);
+
+	fp::fpForest<double> csvForest;
+	EXPECT_THROW(csvForest.load("../res/iris.csv"), std::runtime_error);
+	std::remove(forestFileName.c_str());
+}
+
+TEST(testAUCReturn, loadRejectsCorruptChildren)
+{
+	const std::string forestFileName = "./res/testForestCorrupt.tmp.fp";
+	const int badChild = 1 << 20;
+	for(auto forestType : {"binnedBase", "rfBase"}){
+		fp::fpForest<double> forest;
+		forest.setParameter("forestType", forestType);
+		forest.setParameter("CSVFileName", "../res/iris.csv");
+		forest.setParameter("columnWithY", 4);
+		forest.setParameter("numTreesInForest", 5);
+		forest.setParameter("numTreeBins", 1);
+		forest.setParameter("seed",-1661580697);
+		forest.growForest();
+		forest.save(forestFileName);
+
+		std::fstream savedFile(forestFileName, std::ios::binary | std::ios::in | std::ios::out);
+		if(std::string(forestType) == "binnedBase"){
+			//the left child of the first root, in the node section that
+			//follows the page of roots.
+			savedFile.seekp(2*fp::forestFileSectionAlignment + offsetof(fp::packedNode, left));
+		}else{
+			//the left child of the first tree's root, after its cut values.
+			uint64_t numNodes;
+			savedFile.seekg(sizeof(fp::forestFileHeader) + 8);
+			savedFile.read(reinterpret_cast<char*>(&numNodes), sizeof(numNodes));
+			savedFile.seekp(sizeof(fp::forestFileHeader) + 8 + 8 + numNodes*sizeof(double) + 8);
+		}
+		savedFile.write(reinterpret_cast<const char*>(&badChild), sizeof(badChild));
+		savedFile.close();
+
+		fp::fpForest<double> corruptForest;
+		EXPECT_THROW(corruptForest.load(forestFileName), std::runtime_error) << forestType;
+	}
+	std::remove(forestFileName.c_str());
+}
+
+TEST(testAUCReturn, writeSourceDefinesEveryTree)
+{
+	const std::string sourceFileName = "./res/testForest.tmp.cpp";
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBaseRerF");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 7);
+	forest.setParameter("numTreeBins", 3);
+	forest.setParameter("methodToUse", 1);
+	forest.setParameter("useSummedAreaTables", 0);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+	forest.writeSource(sourceFileName, "irisPredictBatch");
+
+	std::ifstream sourceFile(sourceFileName);
+	std::string source((std::istreambuf_iterator<char>(sourceFile)), std::istreambuf_iterator<char>());
+	for(int tree = 0; tree < 7; ++tree){
+		EXPECT_NE(source.find("inline int tree" + std::to_string(tree) + "(const A& x)"), std::string::npos);
+	}
+	EXPECT_EQ(source.find("inline int tree7("), std::string::npos);
+	EXPECT_NE(source.find("extern \"C\" void irisPredictBatch(const T* X, int numObservations, int numFeatures, bool rowMajor, int* predictions)"), std::string::npos);
+	std::remove(sourceFileName.c_str());
+
+	fp::fpForest<double> rfForest;
+	rfForest.setParameter("forestType", "rfBase");
+	rfForest.setParameter("CSVFileName", "../res/iris.csv");
+	rfForest.setParameter("columnWithY", 4);
+	rfForest.setParameter("numTreesInForest", 2);
+	rfForest.growForest();
+	EXPECT_THROW(rfForest.writeSource(sourceFileName, "irisPredictBatch"), std::runtime_error);
+	std::remove(sourceFileName.c_str());
+}
+
+TEST(testAUCReturn, leafRootsPredictTheirClass)
+{
+	fp::fpForest<double> forest;
+	forest.setParameter("forestType", "binnedBase");
+	forest.setParameter("CSVFileName", "../res/iris.csv");
+	forest.setParameter("columnWithY", 4);
+	forest.setParameter("numTreesInForest", 10);
+	forest.setParameter("minParent", 1000);
+	forest.setParameter("numCores", 1);
+	forest.setParameter("seed",-1661580697);
+	forest.growForest();
+
+	std::vector<int> results;
+	std::vector<double> testCase {5.1,3.5,1.4,0.2};
+	results = forest.predictPost(testCase);
+
+	EXPECT_EQ(results.size(), 3);
+	EXPECT_EQ(results[0]+results[1]+results[2], 10);
+}
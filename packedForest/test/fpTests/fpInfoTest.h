@@ -60,4 +60,81 @@ TEST(fpInfoClass, setMaxDepth)
     // ensures maxDepth defaults to a high number
     fpInfo info2;
     EXPECT_EQ(std::numeric_limits<int>::max(), info2.returnMaxDepth());
-}
\ No newline at end of file
+}
+TEST(fpInfoClass, setParamNumHistogramBins)
+{
+    fpInfo info;
+    EXPECT_EQ(info.returnNumHistogramBins(), 0);
+
+    info.setParameter("numHistogramBins", 64);
+    EXPECT_EQ(info.returnNumHistogramBins(), 64);
+
+    EXPECT_THROW(info.setParameter("numHistogramBins", 1), std::runtime_error);
+    EXPECT_THROW(info.setParameter("numHistogramBins", -2), std::runtime_error);
+}
+
+TEST(fpInfoClass, setParamSortStrategy)
+{
+    fpInfo info;
+    EXPECT_EQ(info.returnSortStrategy(), 0);
+
+    info.setParameter("sortStrategy", 2);
+    EXPECT_EQ(info.returnSortStrategy(), 2);
+
+    EXPECT_THROW(info.setParameter("sortStrategy", 3), std::runtime_error);
+}
+
+TEST(fpInfoClass, setParamSampleFraction)
+{
+    fpInfo info;
+    EXPECT_EQ(info.returnSampleFraction(), 1.0);
+
+    info.setParameter("sampleFraction", 0.5);
+    EXPECT_EQ(info.returnSampleFraction(), 0.5);
+
+    EXPECT_THROW(info.setParameter("sampleFraction", 0.0), std::runtime_error);
+    EXPECT_THROW(info.setParameter("sampleFraction", 1.5), std::runtime_error);
+}
+
+TEST(fpInfoClass, setParamUseSummedAreaTables)
+{
+    fpInfo info;
+    EXPECT_FALSE(info.returnUseSummedAreaTables());
+
+    info.setParameter("useSummedAreaTables", 1);
+    EXPECT_TRUE(info.returnUseSummedAreaTables());
+
+    info.setParameter("useSummedAreaTables", 0.0);
+    EXPECT_FALSE(info.returnUseSummedAreaTables());
+}
+
+TEST(fpInfoClass, setParamComputeOOB)
+{
+    fpInfo info;
+    EXPECT_FALSE(info.returnComputeOOB());
+
+    info.setParameter("computeOOB", 1);
+    EXPECT_TRUE(info.returnComputeOOB());
+}
+
+TEST(fpInfoClass, setParamPredictGroupSize)
+{
+    fpInfo info;
+    EXPECT_EQ(info.returnPredictGroupSize(), 1);
+
+    info.setParameter("predictGroupSize", 16);
+    EXPECT_EQ(info.returnPredictGroupSize(), 16);
+
+    EXPECT_THROW(info.setParameter("predictGroupSize", 0), std::runtime_error);
+}
+
+TEST(fpInfoClass, setParamDepthIntertwined)
+{
+    fpInfo info;
+    EXPECT_EQ(info.returnDepthIntertwined(), -1);
+
+    info.setParameter("depthIntertwined", 3);
+    EXPECT_EQ(info.returnDepthIntertwined(), 3);
+
+    EXPECT_THROW(info.setParameter("depthIntertwined", -2), std::runtime_error);
+}
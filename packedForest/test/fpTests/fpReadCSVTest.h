@@ -1,6 +1,12 @@
 #include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
 #include "../../src/fpSingleton/dataset/fpReadCSV.h"
 
+using namespace fp;
+
 TEST(fpReadCSV, testReadValsCSV)
 {
 	const std::string csvFileName = "./res/testCSV.csv";
@@ -40,3 +46,59 @@ TEST(fpReadCSV, unreadableFile)
 
 	ASSERT_THROW(csvHandle testHandle(csvFileName), std::runtime_error);
 }
+
+
+TEST(fpReadCSV, parseRowsStoresEveryElement)
+{
+	const std::string csvFileName = "./res/testCSV.csv";
+	csvHandle testHandle(csvFileName);
+
+	std::vector<double> values(testHandle.returnNumRows()*testHandle.returnNumColumns());
+	testHandle.parseRows([&](const int row, const int column, const double value){
+		values[row*3+column] = value;
+	});
+
+	for(int i = 0; i < (int)values.size(); ++i){
+		EXPECT_EQ(values[i], i+1);
+	}
+}
+
+
+TEST(fpReadCSV, parseRowsMultipleChunks)
+{
+	const std::string csvFileName = "./res/testCSVLarge.tmp.csv";
+	const int numRows = 30000;
+	{
+		std::ofstream largeCSV(csvFileName);
+		for(int i = 0; i < numRows; ++i){
+			largeCSV << i << "," << i*0.25 << "," << -i << "e-2\n";
+		}
+	}
+
+	csvHandle testHandle(csvFileName, 4);
+	EXPECT_EQ(numRows, testHandle.returnNumRows());
+	EXPECT_EQ(3, testHandle.returnNumColumns());
+
+	std::vector<double> values(numRows*3);
+	testHandle.parseRows([&](const int row, const int column, const double value){
+		values[row*3+column] = value;
+	}, 4);
+
+	for(int i = 0; i < numRows; ++i){
+		EXPECT_EQ(values[i*3], i);
+		EXPECT_EQ(values[i*3+1], i*0.25);
+		EXPECT_EQ(values[i*3+2], -i/100.0);
+	}
+	std::remove(csvFileName.c_str());
+}
+
+
+TEST(fpReadCSV, parseNumberMatchesStrtod)
+{
+	const std::string numbers[] = {"0.1", "-3.14159", "2.5e3", "1e-7", "123456789012345678901", "7.0E+2", "1e300", "0.000001"};
+	for(const std::string& number : numbers){
+		const char* pos = number.data();
+		EXPECT_EQ(std::strtod(number.c_str(), NULL), parseCSVNumber(pos, number.data()+number.size()));
+		EXPECT_EQ(number.data()+number.size(), pos);
+	}
+}
@@ -10,12 +10,15 @@ TEST(testRerFBase, testMaxDepth){
   fpSingleton::getSingleton().setParameter("minParent", 1);
   fpSingleton::getSingleton().setParameter("numCores", 1);
   fpSingleton::getSingleton().setParameter("seed",-1661580697);
+  fpSingleton::getSingleton().loadData();
+  fpSingleton::getSingleton().setDataDependentParameters();
   
   for(int setDepth = 1; setDepth < 10; ++setDepth){
     fpSingleton::getSingleton().setParameter("maxDepth", setDepth);
-    fp::fpRerFBase<double> forest;
+    fp::fpRerFBase<double> forest(fpSingleton::getSingleton());
     forest.growForest();
     std::map<std::string, float> stats = forest.calcTreeStats();
     EXPECT_LE(stats["maxDepth"], setDepth);
   }
+  fpSingleton::getSingleton().deleteData();
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <cstddef>
+#include "../../src/fpSingleton/dataset/inputBinaryData.h"
+
+using namespace fp;
+
+TEST(inputBinaryData, roundTripCSV)
+{
+	const std::string binaryFileName = "./res/testCSV.tmp.bin";
+	convertCSVToBinary<double>("./res/testCSVAllClass.csv", 0, binaryFileName);
+
+	inputCSVData<double,int> csvData("./res/testCSVAllClass.csv", 0);
+	inputBinaryData<double,int> binaryData(binaryFileName);
+
+	ASSERT_EQ(csvData.returnNumObservations(), binaryData.returnNumObservations());
+	ASSERT_EQ(csvData.returnNumFeatures(), binaryData.returnNumFeatures());
+	EXPECT_EQ(csvData.returnNumClasses(), binaryData.returnNumClasses());
+
+	for(int obs = 0; obs < csvData.returnNumObservations(); ++obs){
+		EXPECT_EQ(csvData.returnClassOfObservation(obs), binaryData.returnClassOfObservation(obs));
+		for(int feature = 0; feature < csvData.returnNumFeatures(); ++feature){
+			EXPECT_EQ(csvData.returnFeatureValue(feature, obs), binaryData.returnFeatureValue(feature, obs));
+		}
+	}
+	std::remove(binaryFileName.c_str());
+}
+
+
+TEST(inputBinaryData, rejectsMismatchedType)
+{
+	const std::string binaryFileName = "./res/testCSVFloat.tmp.bin";
+	convertCSVToBinary<float>("./res/testCSVAllClass.csv", 0, binaryFileName);
+
+	typedef inputBinaryData<float,int> floatBinaryData;
+	typedef inputBinaryData<double,int> doubleBinaryData;
+	EXPECT_NO_THROW(floatBinaryData floatData(binaryFileName));
+	EXPECT_THROW(doubleBinaryData doubleData(binaryFileName), std::runtime_error);
+	std::remove(binaryFileName.c_str());
+}
+
+
+TEST(inputBinaryData, rejectsNonBinaryFile)
+{
+	EXPECT_FALSE(binaryDataFile::isBinaryDataset("./res/testCSV.csv"));
+	typedef inputBinaryData<double,int> doubleBinaryData;
+	EXPECT_THROW(doubleBinaryData binaryData("./res/testCSV.csv"), std::runtime_error);
+}
+
+
+TEST(inputBinaryData, rejectsBadBlockOffsets)
+{
+	const std::string binaryFileName = "./res/testCSVOffsets.tmp.bin";
+	typedef inputBinaryData<double,int> doubleBinaryData;
+	//an aligned offset so large that adding the block size would wrap, a
+	//misaligned X block and a misaligned Y block.
+	const std::vector<std::pair<size_t, uint64_t> > badOffsets {
+		{offsetof(binaryDataHeader, xOffset), ~(binaryDataXAlignment-1)},
+		{offsetof(binaryDataHeader, xOffset), binaryDataXAlignment+1},
+		{offsetof(binaryDataHeader, yOffset), binaryDataXAlignment+1}};
+
+	for(auto& badOffset : badOffsets){
+		convertCSVToBinary<double>("./res/testCSVAllClass.csv", 0, binaryFileName);
+		std::fstream binaryFile(binaryFileName, std::ios::binary | std::ios::in | std::ios::out);
+		binaryFile.seekp(badOffset.first);
+		binaryFile.write(reinterpret_cast<const char*>(&badOffset.second), sizeof(badOffset.second));
+		binaryFile.close();
+		EXPECT_THROW(doubleBinaryData binaryData(binaryFileName), std::runtime_error);
+	}
+	std::remove(binaryFileName.c_str());
+}
@@ -169,3 +169,35 @@ TEST(inNodeClassTotals, copyClassTotals)
 	EXPECT_LT(testTotalsTwo.returnImpurity(), 1.35);
 
 }
+
+
+TEST(inNodeClassTotals, incrementalImpurityMatchesClassTotals)
+{
+	int numClasses = 4;
+	inNodeClassTotals testTotals(numClasses);
+
+	testTotals.addToClass(0, 7);
+	testTotals.addToClass(3, 5);
+	testTotals.incrementClass(1);
+	testTotals.incrementClass(3);
+	testTotals.removeFromClass(0, 2);
+	testTotals.decrementClass(1);
+	testTotals.addToClass(2, 4);
+
+	std::vector<int> classVec {5, 0, 4, 6};
+	float expected = 0;
+	for(auto i : classVec){
+		expected += (float)i*(1.0-(float)i/15.0);
+	}
+
+	EXPECT_EQ(testTotals.returnNumItems(), 15);
+	EXPECT_NEAR(testTotals.calcAndReturnImpurity(), expected, 1e-4);
+
+	inNodeClassTotals copiedTotals(numClasses);
+	copiedTotals.copyInNodeClassTotals(testTotals);
+	EXPECT_EQ(copiedTotals.calcAndReturnImpurity(), testTotals.calcAndReturnImpurity());
+
+	testTotals.resetClassTotals();
+	testTotals.incrementClass(2);
+	EXPECT_EQ(testTotals.calcAndReturnImpurity(), 0);
+}
@@ -54,8 +54,36 @@ TEST(nodeIterators, basicFunctions)
 		EXPECT_EQ(indexHolder.returnClassVector(i).begin()+1, testInitial.returnBeginIterator(i));
 		EXPECT_EQ(indexHolder.returnClassVector(i).end()-1, testInitial.returnEndIterator(i));
 	}
+}
 
 
+TEST(nodeIterators, childrenFollowSplit)
+{
+	int classSize = 6;
+	int numClasses = 2;
 
-}
+	obsIndexAndClassVec indexHolder(numClasses);
+	for(int i = 0; i < classSize*numClasses; ++i){
+		indexHolder.insertIndex(i, i % numClasses);
+	}
+
+	nodeIterators parent(numClasses);
+	parent.setInitialIterators(indexHolder);
+	for(int i = 0; i < numClasses; ++i){
+		parent.loadSplitIterator(parent.returnBeginIterator(i)+i+1);
+	}
+	EXPECT_EQ(parent.returnLeftChildSize(), 3);
+
+	nodeIterators leftChild(numClasses);
+	nodeIterators rightChild(numClasses);
+	leftChild.setNodeIterators(parent, true);
+	rightChild.setNodeIterators(parent, false);
 
+	for(int i = 0; i < numClasses; ++i){
+		EXPECT_EQ(leftChild.returnBeginIterator(i), indexHolder.returnClassVector(i).begin());
+		EXPECT_EQ(leftChild.returnEndIterator(i), parent.returnSplitIterator(i));
+		EXPECT_EQ(rightChild.returnBeginIterator(i), parent.returnSplitIterator(i));
+		EXPECT_EQ(rightChild.returnEndIterator(i), indexHolder.returnClassVector(i).end());
+		EXPECT_EQ(leftChild.returnClassSize(i)+rightChild.returnClassSize(i), classSize);
+	}
+}
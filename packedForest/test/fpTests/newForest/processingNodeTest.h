@@ -21,7 +21,7 @@ TEST(processingNodeTest, setupRootNodeRF)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -42,7 +42,7 @@ TEST(processingNodeTest, setupRootNodeRF)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	EXPECT_EQ(testRootNode.exposeTreeNum(), treeNum);
@@ -84,7 +84,7 @@ TEST(processingNodeTest, loadStandardRFZip)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -104,7 +104,7 @@ TEST(processingNodeTest, loadStandardRFZip)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 0;
@@ -113,7 +113,7 @@ TEST(processingNodeTest, loadStandardRFZip)
 	float accumulator = 0;
 	for(int i = 0; i < testSize; ++i){
 		float testFromZip = (float)(testRootNode.exposeZipIters().returnZipBegin()+i)->returnFeatureVal();
-		float testFromData = (float)fpSingleton::getSingleton().returnFeatureVal(testFeature,i);
+		float testFromData = (float)fpSingleton::getSingleton().returnFeatureVal<float>(testFeature,i);
 		EXPECT_EQ(testFromZip, testFromData);
 		accumulator += testFromZip;
 	}
@@ -140,7 +140,7 @@ TEST(processingNodeTest, findBestSplit)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -161,7 +161,7 @@ TEST(processingNodeTest, findBestSplit)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -204,7 +204,7 @@ TEST(processingNodeTest, moveLeftRight)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -224,7 +224,7 @@ TEST(processingNodeTest, moveLeftRight)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -281,7 +281,7 @@ TEST(processingNodeTest, moveLeft)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -301,7 +301,7 @@ TEST(processingNodeTest, moveLeft)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -321,7 +321,7 @@ testRootNode.setAsLeafNode();
 
 	treeNum = treeNum+1;
 	nodeNum = nodeNum+1;
-	processingNode<float, int> testNextNode(treeNum,nodeNum);
+	processingNode<float, int> testNextNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testNextNode.setupNode(testRootNode, true);
 
 	EXPECT_EQ(testNextNode.exposeTreeNum(), treeNum);
@@ -354,7 +354,7 @@ TEST(processingNodeTest, moveRight)
 	std::string p2 = "../res/iris.csv";
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -375,7 +375,7 @@ TEST(processingNodeTest, moveRight)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -390,7 +390,7 @@ TEST(processingNodeTest, moveRight)
 
 	treeNum = treeNum+1;
 	nodeNum = nodeNum+1;
-	processingNode<float, int> testNextNode(treeNum,nodeNum);
+	processingNode<float, int> testNextNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testNextNode.setupNode(testRootNode, false);
 
 	EXPECT_EQ(testNextNode.exposeTreeNum(), treeNum);
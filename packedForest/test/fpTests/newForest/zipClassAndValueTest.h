@@ -1,4 +1,7 @@
 #include "../../../src/forestTypes/newForest/zipClassAndValue.h"
+#include "../../../src/baseFunctions/radixSort.h"
+#include <random>
+#include <algorithm>
 
 using namespace fp;
 
@@ -37,3 +40,48 @@ TEST(zipClassAndValue, basicFunctions)
 	EXPECT_FALSE(firstTuple.checkInequality(secondTuple));
 }
 
+
+
+TEST(zipClassAndValue, radixSortMatchesSort)
+{
+	std::mt19937 eng(7);
+	std::uniform_real_distribution<float> floatDist(-1000, 1000);
+	std::uniform_int_distribution<int> intDist(-50000, 50000);
+
+	std::vector<zipClassAndValue<int, float> > floats(5000);
+	std::vector<zipClassAndValue<int, int> > ints(5000);
+	std::vector<zipClassAndValue<int, double> > doubles(5000);
+	for(int i = 0; i < 5000; ++i){
+		floats[i].setPair(i%3, (i%7==0) ? -0.0f : floatDist(eng));
+		ints[i].setPair(i%3, intDist(eng));
+		doubles[i].setPair(i%3, (double)floatDist(eng));
+	}
+
+	std::vector<zipClassAndValue<int, float> > floatBuffer;
+	std::vector<zipClassAndValue<int, int> > intBuffer;
+	std::vector<zipClassAndValue<int, double> > doubleBuffer;
+	std::vector<zipClassAndValue<int, float> > sortedFloats(floats);
+	std::vector<zipClassAndValue<int, int> > sortedInts(ints);
+	std::vector<zipClassAndValue<int, double> > sortedDoubles(doubles);
+	std::stable_sort(sortedFloats.begin(), sortedFloats.end());
+	std::stable_sort(sortedInts.begin(), sortedInts.end());
+	std::stable_sort(sortedDoubles.begin(), sortedDoubles.end());
+	radixSort(floats.begin(), floats.end(), floatBuffer);
+	radixSort(ints.begin(), ints.end(), intBuffer);
+	radixSort(doubles.begin(), doubles.end(), doubleBuffer);
+
+	for(int i = 0; i < 5000; ++i){
+		EXPECT_EQ(floats[i].returnFeatureVal(), sortedFloats[i].returnFeatureVal());
+		EXPECT_EQ(ints[i].returnFeatureVal(), sortedInts[i].returnFeatureVal());
+		EXPECT_EQ(ints[i].returnObsClass(), sortedInts[i].returnObsClass());
+		EXPECT_EQ(doubles[i].returnFeatureVal(), sortedDoubles[i].returnFeatureVal());
+	}
+}
+
+
+TEST(zipClassAndValue, recordsAreNotPadded)
+{
+	EXPECT_EQ(sizeof(zipClassAndValue<int, float>), (size_t)8);
+	EXPECT_EQ(sizeof(zipClassAndValue<int, int>), (size_t)8);
+	EXPECT_EQ(sizeof(zipClassAndValue<int, double>), (size_t)16);
+}
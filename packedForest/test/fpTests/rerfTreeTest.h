@@ -5,7 +5,7 @@
 
 TEST(testRerFtree, testOOB){
 
-	fp::fpRerFBase<double> forest;
+	fp::fpRerFBase<double> forest(fpSingleton::getSingleton());
 	fp::fpSingleton::getSingleton().setParameter("CSVFileName", "../res/iris.csv");
 	fp::fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fp::fpSingleton::getSingleton().setParameter("numTreesInForest", 1);
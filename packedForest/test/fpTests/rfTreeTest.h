@@ -5,7 +5,7 @@
 
 TEST(testRFtree, testOOB){
 
-	fp::fpForestClassificationBase<double> forest;
+	fp::fpForestClassificationBase<double> forest(fpSingleton::getSingleton());
 	fp::fpSingleton::getSingleton().setParameter("CSVFileName", "../res/iris.csv");
 	fp::fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fp::fpSingleton::getSingleton().setParameter("numTreesInForest", 1);
@@ -23,7 +23,7 @@ TEST(processingNodeUnsupervisedTest, setupRootNodeRF)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -44,7 +44,7 @@ TEST(processingNodeUnsupervisedTest, setupRootNodeRF)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	EXPECT_EQ(testRootNode.exposeTreeNum(), treeNum);
@@ -87,7 +87,7 @@ TEST(processingNodeUnsupervisedTest, loadStandardRFZip)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -107,7 +107,7 @@ TEST(processingNodeUnsupervisedTest, loadStandardRFZip)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 0;
@@ -116,7 +116,7 @@ TEST(processingNodeUnsupervisedTest, loadStandardRFZip)
 	float accumulator = 0;
 	for(int i = 0; i < testSize; ++i){
 		float testFromZip = (float)(testRootNode.exposeZipIters().returnZipBegin()+i)->returnFeatureVal();
-		float testFromData = (float)fpSingleton::getSingleton().returnFeatureVal(testFeature,i);
+		float testFromData = (float)fpSingleton::getSingleton().returnFeatureVal<float>(testFeature,i);
 		EXPECT_EQ(testFromZip, testFromData);
 		accumulator += testFromZip;
 	}
@@ -144,7 +144,7 @@ TEST(processingNodeUnsupervisedTest, findBestSplit)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -165,7 +165,7 @@ TEST(processingNodeUnsupervisedTest, findBestSplit)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -209,7 +209,7 @@ TEST(processingNodeUnsupervisedTest, moveLeftRight)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -229,7 +229,7 @@ TEST(processingNodeUnsupervisedTest, moveLeftRight)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -287,7 +287,7 @@ TEST(processingNodeUnsupervisedTest, moveLeft)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -307,7 +307,7 @@ TEST(processingNodeUnsupervisedTest, moveLeft)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -327,7 +327,7 @@ testRootNode.setAsLeafNode();
 
 	treeNum = treeNum+1;
 	nodeNum = nodeNum+1;
-	processingNode<float, int> testNextNode(treeNum,nodeNum);
+	processingNode<float, int> testNextNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testNextNode.setupNode(testRootNode, true);
 
 	EXPECT_EQ(testNextNode.exposeTreeNum(), treeNum);
@@ -361,7 +361,7 @@ TEST(processingNodeUnsupervisedTest, moveRight)
 	fpSingleton::getSingleton().setParameter(p1, p2);
 	fpSingleton::getSingleton().setParameter("columnWithY", 4);
 	fpSingleton::getSingleton().setParameter("forestType", "urf");
-	fpSingleton::getSingleton().loadData();
+	fpSingleton::getSingleton().loadData<float>();
 	fpSingleton::getSingleton().setDataDependentParameters();
 
 	int numClasses = fpSingleton::getSingleton().returnNumClasses();
@@ -382,7 +382,7 @@ TEST(processingNodeUnsupervisedTest, moveRight)
 
 	int treeNum = 1;
 	int nodeNum = 0;
-	processingNode<float, int> testRootNode(treeNum,nodeNum);
+	processingNode<float, int> testRootNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testRootNode.setupRoot(indexHolder, zipVec);
 
 	int testFeature = 3;
@@ -397,7 +397,7 @@ TEST(processingNodeUnsupervisedTest, moveRight)
 
 	treeNum = treeNum+1;
 	nodeNum = nodeNum+1;
-	processingNode<float, int> testNextNode(treeNum,nodeNum);
+	processingNode<float, int> testNextNode(treeNum,nodeNum, fpSingleton::getSingleton());
 	testNextNode.setupNode(testRootNode, false);
 
 	EXPECT_EQ(testNextNode.exposeTreeNum(), treeNum);
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 
-//#include "fpTests/fpReadCSVTest.h"
+#include "fpTests/fpReadCSVTest.h"
+#include "fpTests/inputBinaryDataTest.h"
+#include "fpTests/dataAccessorsTest.h"
 //#include "fpTests/fpDataSetTest.h"
 //#include "fpTests/fpInNodeClassIndices.h"
 //#include "fpTests/stratifiedInNodeClassIndicesTest.h"
@@ -23,6 +25,7 @@
 #include "fpTests/binnedBaseTest.h"
 #include "fpTests/fpForestTest.h"
 #include "fpTests/binnedForest/processingNodeBinTest.h"
+#include "fpTests/binnedForest/packedBinTest.h"
 #include "fpTests/rfTreeTest.h"
 #include "fpTests/rerfTreeTest.h"
 #include "fpTests/fpSingletonTest.h"